@@ -0,0 +1,865 @@
+#ifndef ADDRESSABLE_PRIORITY_QUEUE_HPP_
+#define ADDRESSABLE_PRIORITY_QUEUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>              //For std::swap function
+#include <algorithm>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "priority_queue.hpp"
+#include "array_stack.hpp"
+
+
+namespace ics {
+
+//A heap-based priority queue whose values can be named by Handles: enqueue_handle
+//  returns one, and with it a value can be found, given a new priority, or
+//  erased in O(log N) (e.g., for decrease-key in Dijkstra's algorithm).
+//Values stay in the slot they were enqueued into; the heap orders slot indexes,
+//  and position records where in the heap each slot is.
+template<class T> class AddressablePriorityQueue : public PriorityQueue<T>  {
+  using PriorityQueue<T>::gt;  //Required because of templated classes
+  public:
+    //Names one value while it is in the queue; once it is dequeued or erased
+    //  its Handle is no longer contained, even if its slot is reused
+    class Handle {
+      public:
+        Handle() : slot(-1), generation(0) {}
+        bool operator == (const Handle& rhs) const {return slot == rhs.slot && generation == rhs.generation;}
+        bool operator != (const Handle& rhs) const {return !(*this == rhs);}
+      private:
+        Handle(int s, int g) : slot(s), generation(g) {}
+        int slot;
+        int generation;
+        friend class AddressablePriorityQueue<T>;
+    };
+
+    AddressablePriorityQueue() = delete;
+    explicit AddressablePriorityQueue(bool (*agt)(const T& a, const T& b));
+    AddressablePriorityQueue(int initialLength,bool (*agt)(const T& a, const T& b));
+    AddressablePriorityQueue(const AddressablePriorityQueue<T>& to_copy);
+    AddressablePriorityQueue(AddressablePriorityQueue<T>&& to_move);
+    AddressablePriorityQueue(std::initializer_list<T> il,bool (*agt)(const T& a, const T& b));
+    AddressablePriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop,bool (*agt)(const T& a, const T& b));
+    virtual ~AddressablePriorityQueue();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual T&   peek       () const;
+    virtual std::string str () const;
+
+    virtual int  enqueue (const T& element);
+    virtual T    dequeue ();
+    virtual void clear   ();
+
+    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> enqueue (const ITERATOR& start, const ITERATOR& stop);
+
+    Handle   enqueue_handle  (const T& element);   //enqueue, returning a Handle for element
+    Handle   peek_handle     () const;             //Handle for the value peek returns
+    bool     contains        (const Handle& h) const;
+    const T& operator []     (const Handle& h) const;
+    void     update_priority (const Handle& h, const T& new_value);
+    T        erase           (const Handle& h);
+
+    void reserve (int n); //Room for n values without reallocating
+
+    virtual AddressablePriorityQueue<T>& operator = (const AddressablePriorityQueue<T>& rhs);
+    virtual AddressablePriorityQueue<T>& operator = (AddressablePriorityQueue<T>&& rhs);
+    virtual bool operator == (const PriorityQueue<T>& rhs) const;
+    virtual bool operator != (const PriorityQueue<T>& rhs) const;
+
+    template<class T2>
+    friend std::ostream& operator << (std::ostream& outs, const AddressablePriorityQueue<T2>& p);
+
+    virtual ics::Iterator<T>& ibegin() const;
+    virtual ics::Iterator<T>& iend  () const;
+
+    //Iterators visit values in priority order (highest first), searching the
+    //  heap top-down as HeapPriorityQueue's do: frontier is a heap of the heap
+    //  positions that can be visited next
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(AddressablePriorityQueue<T>* iterate_over, bool begin);
+        Iterator(const Iterator& i);
+        Iterator(Iterator&& i);
+        Iterator& operator = (Iterator i);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+        Handle handle () const;  //Handle for the current value
+      private:
+        AddressablePriorityQueue<T>* ref_pq;
+        int                          current;          //Heap position; -1 when exhausted
+        int*                         frontier        = nullptr;
+        int                          frontier_length = 0;
+        int                          frontier_used   = 0;
+        int                          expected_mod_count;
+        bool                         can_erase = true;
+        bool before        (int a, int b) const;  //Value at heap position a has higher priority
+        void advance       ();
+        void push_children (int i);
+        void push_frontier (int i);
+        int  pop_frontier  ();
+        void erase_frontier(int i);
+        bool visited       (int i) const;
+    };
+
+    virtual Iterator begin() const;
+    virtual Iterator end  () const;
+
+  private:
+    //See base class PriorityQueue
+    //bool (*gt)(const T& a, const T& b);// gt(a,b) = true iff a has higher priority than b
+    //heap holds every slot: heap[0,used) are the slots of values in the queue,
+    //  ordered as a heap; heap[used,length) are the free slots
+    T*   values;                         //values[s] is the value in slot s
+    int* heap;
+    int* position;                       //heap[position[s]] == s
+    int* generation;                     //# times slot s has been freed
+    int  length    = 0;                  //Physical length of the arrays
+    int  used      = 0;                  //# values in the queue
+    int  mod_count = 0;                  //For sensing concurrent modification
+    void ensure_length(int new_length);
+    void reallocate   (int new_length);
+    int  slot_of      (const Handle& h, const std::string& where) const;
+    void place        (int i, int slot); //heap[i] = slot, updating position
+    void remove_at    (int i);           //Remove the value at heap position i (its slot is freed)
+    int  left_child     (int i);         //Useful abstractions for heaps as arrays
+    int  right_child    (int i);
+    int  parent         (int i);
+    bool is_root        (int i);
+    bool in_heap        (int i);
+    bool higher         (int i, int j);  //Value at heap position i has higher priority
+    int  percolate_up   (int i);         //Both return the value's final position
+    int  percolate_down (int i);
+    void heapify        ();
+  };
+
+
+
+
+
+template<class T>
+AddressablePriorityQueue<T>::AddressablePriorityQueue(bool (*agt)(const T& a, const T& b))
+  : PriorityQueue<T>(agt) {
+  values     = new T[length];
+  heap       = new int[length];
+  position   = new int[length];
+  generation = new int[length];
+}
+
+template<class T>
+AddressablePriorityQueue<T>::AddressablePriorityQueue(int initial_length, bool (*agt)(const T& a, const T& b))
+  : AddressablePriorityQueue<T>(agt) {
+  reserve(initial_length);
+}
+
+template<class T>
+AddressablePriorityQueue<T>::AddressablePriorityQueue(const AddressablePriorityQueue<T>& to_copy)
+  : PriorityQueue<T>(to_copy.gt), length(to_copy.length), used(to_copy.used) {
+  values     = new T[length];
+  heap       = new int[length];
+  position   = new int[length];
+  generation = new int[length];
+  for (int s=0; s<length; ++s) {
+    heap[s]       = to_copy.heap[s];
+    position[s]   = to_copy.position[s];
+    generation[s] = to_copy.generation[s];
+  }
+  for (int i=0; i<used; ++i)
+    values[heap[i]] = to_copy.values[heap[i]];
+}
+
+
+template<class T>
+AddressablePriorityQueue<T>::AddressablePriorityQueue(AddressablePriorityQueue<T>&& to_move)
+  : AddressablePriorityQueue<T>(to_move.gt) {
+  *this = std::move(to_move);
+}
+
+template<class T>
+AddressablePriorityQueue<T>::AddressablePriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop, bool (*agt)(const T& a, const T& b))
+  : AddressablePriorityQueue<T>(agt) {
+  for (; start != stop; ++start) {
+    this->ensure_length(used+1);
+    values[heap[used++]] = *start;
+  }
+  heapify();
+}
+
+template<class T>
+AddressablePriorityQueue<T>::AddressablePriorityQueue(std::initializer_list<T> il, bool (*agt)(const T& a, const T& b))
+  : AddressablePriorityQueue<T>(il.size(),agt) {
+  for (const T& pq_elem : il)
+    values[heap[used++]] = pq_elem;
+  heapify();
+}
+
+
+template<class T>
+AddressablePriorityQueue<T>::~AddressablePriorityQueue() {
+  delete[] values;
+  delete[] heap;
+  delete[] position;
+  delete[] generation;
+}
+
+
+template<class T>
+inline bool AddressablePriorityQueue<T>::empty() const {
+  return used == 0;
+}
+
+template<class T>
+int AddressablePriorityQueue<T>::size() const {
+  return used;
+}
+
+template<class T>
+T& AddressablePriorityQueue<T>::peek () const {
+  if (empty())
+    throw EmptyError("AddressablePriorityQueue::peek");
+
+  return values[heap[0]];
+}
+
+template<class T>
+std::string AddressablePriorityQueue<T>::str() const {
+  std::ostringstream answer;
+  if (empty()) {
+    answer << "priority_queue[]";
+  }else{
+    answer << "priority_queue[";
+    for (int i=0; i<used; ++i)
+      answer << (i == 0 ? "" : ",") << values[heap[i]] << "@" << heap[i];
+    answer << "]";
+  }
+  answer << "(length=" << length << ",used=" << used << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+template<class T>
+int AddressablePriorityQueue<T>::enqueue(const T& element) {
+  enqueue_handle(element);
+  return 1;
+}
+
+template<class T>
+T AddressablePriorityQueue<T>::dequeue() {
+  if (this->empty())
+    throw EmptyError("AddressablePriorityQueue::dequeue");
+
+  T to_return = std::move(values[heap[0]]);
+  remove_at(0);
+  ++mod_count;
+  return to_return;
+}
+
+template<class T>
+void AddressablePriorityQueue<T>::clear() {
+  for (int i=0; i<used; ++i)
+    ++generation[heap[i]];
+  used = 0;
+  ++mod_count;
+}
+
+template<class T>
+int AddressablePriorityQueue<T>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += enqueue(*start);
+
+  return count;
+}
+
+
+template<class T>
+template<class ITERATOR>
+auto AddressablePriorityQueue<T>::enqueue (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i)
+    count += enqueue(*i);
+
+  return count;
+}
+
+
+template<class T>
+auto AddressablePriorityQueue<T>::enqueue_handle(const T& element) -> Handle {
+  this->ensure_length(used+1);
+  int slot = heap[used++];
+  values[slot] = element;
+
+  percolate_up(used-1);
+  ++mod_count;
+  return Handle(slot,generation[slot]);
+}
+
+
+template<class T>
+auto AddressablePriorityQueue<T>::peek_handle() const -> Handle {
+  if (empty())
+    throw EmptyError("AddressablePriorityQueue::peek_handle");
+
+  return Handle(heap[0],generation[heap[0]]);
+}
+
+
+template<class T>
+bool AddressablePriorityQueue<T>::contains(const Handle& h) const {
+  return h.slot >= 0 && h.slot < length && position[h.slot] < used && generation[h.slot] == h.generation;
+}
+
+
+template<class T>
+const T& AddressablePriorityQueue<T>::operator [] (const Handle& h) const {
+  return values[slot_of(h,"AddressablePriorityQueue::operator []")];
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::update_priority(const Handle& h, const T& new_value) {
+  int slot = slot_of(h,"AddressablePriorityQueue::update_priority");
+  values[slot] = new_value;
+  percolate_down(percolate_up(position[slot]));
+  ++mod_count;
+}
+
+
+template<class T>
+T AddressablePriorityQueue<T>::erase(const Handle& h) {
+  int slot = slot_of(h,"AddressablePriorityQueue::erase");
+  T to_return = std::move(values[slot]);
+  remove_at(position[slot]);
+  ++mod_count;
+  return to_return;
+}
+
+
+template<class T>
+AddressablePriorityQueue<T>& AddressablePriorityQueue<T>::operator = (const AddressablePriorityQueue<T>& rhs) {
+  if (this == &rhs)
+    return *this;
+  AddressablePriorityQueue<T> copy(rhs);
+  *this = std::move(copy);
+  return *this;
+}
+
+
+template<class T>
+AddressablePriorityQueue<T>& AddressablePriorityQueue<T>::operator = (AddressablePriorityQueue<T>&& rhs) {
+  std::swap(values,    rhs.values);  //rhs gets (and later deletes) the old arrays
+  std::swap(heap,      rhs.heap);
+  std::swap(position,  rhs.position);
+  std::swap(generation,rhs.generation);
+  std::swap(length,    rhs.length);
+  std::swap(used,      rhs.used);
+  std::swap(gt,        rhs.gt);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+template<class T>
+bool AddressablePriorityQueue<T>::operator == (const PriorityQueue<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+  //KLUDGE: should check for == function used to prioritize, but cannot unless
+  //  this is made part of the PriorityQueue class (should it be? protected)?
+  const AddressablePriorityQueue<T>* rhsAPQ = dynamic_cast<const AddressablePriorityQueue<T>*>(&rhs);
+  if (rhsAPQ != nullptr) {
+    for (Iterator l = begin(), r = rhsAPQ->begin(); l != end(); ++l, ++r)
+      if (*l != *r)
+        return false;
+    return true;
+  }
+
+  bool answer = true;
+  ics::Iterator<T>& r = rhs.ibegin();
+  for (Iterator l = begin(); answer && l != end(); ++l, ++r)
+    answer = !(*l != *r);
+  delete &r;  //ibegin returns a heap-allocated iterator
+  return answer;
+}
+
+template<class T>
+bool AddressablePriorityQueue<T>::operator != (const PriorityQueue<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+template<class T>
+std::ostream& operator << (std::ostream& outs, const AddressablePriorityQueue<T>& p) {
+  if (p.empty()) {
+    outs << "priority_queue[]";
+  }else{
+    outs << "priority_queue[";
+    ArrayStack<const T*> temp(p.used);
+    for (const T& v : p)
+      temp.push(&v);
+    for (int i=0; i<p.used-1; ++i)
+      outs << *temp.pop() << ",";
+    outs << *temp.pop() << "]:highest";
+  }
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T>
+auto AddressablePriorityQueue<T>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<AddressablePriorityQueue<T>*>(this),true));
+}
+
+//KLUDGE: memory-leak
+template<class T>
+auto AddressablePriorityQueue<T>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<AddressablePriorityQueue<T>*>(this),false));
+}
+
+template<class T>
+auto AddressablePriorityQueue<T>::begin () const -> AddressablePriorityQueue<T>::Iterator {
+  return Iterator(const_cast<AddressablePriorityQueue<T>*>(this),true);
+}
+
+template<class T>
+auto AddressablePriorityQueue<T>::end () const -> AddressablePriorityQueue<T>::Iterator {
+  return Iterator(const_cast<AddressablePriorityQueue<T>*>(this),false);
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::ensure_length(int new_length) {
+  if (length >= new_length)
+    return;
+  reallocate(std::max(new_length,2*length));
+}
+
+
+//New slots are free: they go at the end of heap
+template<class T>
+void AddressablePriorityQueue<T>::reallocate(int new_length) {
+  T*   old_values     = values;
+  int* old_heap       = heap;
+  int* old_position   = position;
+  int* old_generation = generation;
+  values     = new T[new_length];
+  heap       = new int[new_length];
+  position   = new int[new_length];
+  generation = new int[new_length];
+  for (int s=0; s<length; ++s) {
+    heap[s]       = old_heap[s];
+    position[s]   = old_position[s];
+    generation[s] = old_generation[s];
+  }
+  for (int i=0; i<used; ++i)
+    values[heap[i]] = std::move(old_values[heap[i]]);
+  for (int s=length; s<new_length; ++s) {
+    heap[s]       = s;
+    position[s]   = s;
+    generation[s] = 0;
+  }
+  length = new_length;
+
+  delete [] old_values;
+  delete [] old_heap;
+  delete [] old_position;
+  delete [] old_generation;
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::reserve(int n) {
+  if (length < n)
+    reallocate(n);
+}
+
+
+template<class T>
+int AddressablePriorityQueue<T>::slot_of(const Handle& h, const std::string& where) const {
+  if (!contains(h))
+    throw KeyError(where+": handle not in queue");
+  return h.slot;
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::place(int i, int slot) {
+  heap[i] = slot;
+  position[slot] = i;
+}
+
+
+//The last value fills position i, and the removed slot becomes the first free one
+template<class T>
+void AddressablePriorityQueue<T>::remove_at(int i) {
+  int slot = heap[i];
+  int last = --used;
+  if (i != last) {
+    place(i,heap[last]);
+    place(last,slot);
+    percolate_down(percolate_up(i));
+  }
+  ++generation[slot];
+}
+
+template<class T>
+int AddressablePriorityQueue<T>::left_child(int i)
+{return 2*i+1;}
+
+template<class T>
+int AddressablePriorityQueue<T>::right_child(int i)
+{return 2*i+2;}
+
+template<class T>
+int AddressablePriorityQueue<T>::parent(int i)
+{return (i-1)/2;}
+
+template<class T>
+bool AddressablePriorityQueue<T>::is_root(int i)
+{return i == 0;}
+
+template<class T>
+bool AddressablePriorityQueue<T>::in_heap(int i)
+{return i < used;}
+
+template<class T>
+bool AddressablePriorityQueue<T>::higher(int i, int j)
+{return gt(values[heap[i]],values[heap[j]]);}
+
+template<class T>
+int AddressablePriorityQueue<T>::percolate_up(int i) {
+  int slot = heap[i];
+  for (/*parameter*/; !is_root(i) && gt(values[slot],values[heap[parent(i)]]); i = parent(i))
+    place(i,heap[parent(i)]);
+  place(i,slot);
+  return i;
+}
+
+
+template<class T>
+int AddressablePriorityQueue<T>::percolate_down(int i) {
+  int slot = heap[i];
+  for (int l = left_child(i); in_heap(l); l = left_child(i)) {
+    int r = right_child(i);
+    int max = !in_heap(r) || higher(l,r) ? l : r;
+    if ( gt(values[slot],values[heap[max]]) )
+       break;
+    place(i,heap[max]);
+    i = max;
+  }
+  place(i,slot);
+  return i;
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::heapify() {
+  for (int i=parent(used-1); i>=0; --i)
+    percolate_down(i);
+}
+
+
+
+
+
+template<class T>
+AddressablePriorityQueue<T>::Iterator::Iterator(AddressablePriorityQueue<T>* iterate_over, bool begin)
+  : ref_pq(iterate_over), current(begin && !iterate_over->empty() ? 0 : -1) {
+  expected_mod_count = ref_pq->mod_count;
+}
+
+template<class T>
+AddressablePriorityQueue<T>::Iterator::Iterator(const Iterator& i) :
+    ref_pq(i.ref_pq), current(i.current),
+    frontier_length(i.frontier_used), frontier_used(i.frontier_used),
+    expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {
+  if (frontier_length > 0) {
+    frontier = new int[frontier_length];
+    for (int f=0; f<frontier_used; ++f)
+      frontier[f] = i.frontier[f];
+  }
+}
+
+template<class T>
+AddressablePriorityQueue<T>::Iterator::Iterator(Iterator&& i) :
+    ref_pq(i.ref_pq), current(i.current), frontier(i.frontier),
+    frontier_length(i.frontier_length), frontier_used(i.frontier_used),
+    expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {
+  i.frontier = nullptr;
+  i.frontier_length = i.frontier_used = 0;
+}
+
+//i is a copy (or was moved from an rvalue); it deletes this iterator's old frontier
+template<class T>
+auto AddressablePriorityQueue<T>::Iterator::operator = (Iterator i) -> Iterator& {
+  std::swap(ref_pq,            i.ref_pq);
+  std::swap(current,           i.current);
+  std::swap(frontier,          i.frontier);
+  std::swap(frontier_length,   i.frontier_length);
+  std::swap(frontier_used,     i.frontier_used);
+  std::swap(expected_mod_count,i.expected_mod_count);
+  std::swap(can_erase,         i.can_erase);
+  return *this;
+}
+
+template<class T>
+AddressablePriorityQueue<T>::Iterator::~Iterator() {
+  delete[] frontier;
+}
+
+//As in HeapPriorityQueue::Iterator::erase: visited values stay visited and
+//  unvisited ones stay unvisited, so the traversal continues correctly
+template<class T>
+T AddressablePriorityQueue<T>::Iterator::erase() {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("AddressablePriorityQueue::Iterator::erase Iterator cursor already erased");
+  if (current < 0)
+    throw CannotEraseError("AddressablePriorityQueue::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  int slot = ref_pq->heap[current];
+  T to_return = std::move(ref_pq->values[slot]);
+  int last = --ref_pq->used;
+
+  if (current != last) {
+    int last_slot = ref_pq->heap[last];
+    if (!visited(last)) {
+      erase_frontier(last);
+      int hole = current;
+      for (int l = ref_pq->left_child(hole); ref_pq->in_heap(l); l = ref_pq->left_child(hole)) {
+        int r = ref_pq->right_child(hole);
+        int max = !ref_pq->in_heap(r) || ref_pq->higher(l,r) ? l : r;
+        ref_pq->place(hole,ref_pq->heap[max]);
+        hole = max;
+      }
+      ref_pq->place(hole,last_slot);
+      ref_pq->percolate_up(hole);
+      push_frontier(current);
+    }else{
+      ref_pq->place(current,last_slot);
+      ref_pq->percolate_up(current);
+      push_children(current);
+    }
+    ref_pq->place(last,slot);
+  }
+  ++ref_pq->generation[slot];
+
+  ++ref_pq->mod_count;
+  expected_mod_count = ref_pq->mod_count;
+  return to_return;
+}
+
+template<class T>
+std::string AddressablePriorityQueue<T>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_pq->str() << "/current=" << current << "/frontier=[";
+  for (int f=0; f<frontier_used; ++f)
+    answer << (f == 0 ? "" : ",") << frontier[f];
+  answer << "]/expected_mod_count=" << expected_mod_count << "/can_erase=" << can_erase;
+  return answer.str();
+}
+
+
+template<class T>
+const ics::Iterator<T>& AddressablePriorityQueue<T>::Iterator::operator ++ () {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::operator ++");
+
+  advance();
+  return *this;
+}
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T>
+const ics::Iterator<T>& AddressablePriorityQueue<T>::Iterator::operator ++ (int) {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::operator ++(int)");
+
+  Iterator* to_return = new Iterator(*this);
+  advance();
+  return *to_return;
+}
+
+template<class T>
+bool AddressablePriorityQueue<T>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("AddressablePriorityQueue::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T>
+bool AddressablePriorityQueue<T>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::operator ==");
+  if (ref_pq != rhs.ref_pq)
+    throw ComparingDifferentIteratorsError("AddressablePriorityQueue::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class T>
+bool AddressablePriorityQueue<T>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("AddressablePriorityQueue::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T>
+bool AddressablePriorityQueue<T>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::operator !=");
+  if (ref_pq != rhs.ref_pq)
+    throw ComparingDifferentIteratorsError("AddressablePriorityQueue::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+template<class T>
+T& AddressablePriorityQueue<T>::Iterator::operator *() const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::operator *");
+  if (!can_erase || current < 0)
+    throw IteratorPositionIllegal("AddressablePriorityQueue::Iterator::operator * Iterator illegal: exhausted");
+
+  return ref_pq->values[ref_pq->heap[current]];
+}
+
+template<class T>
+T* AddressablePriorityQueue<T>::Iterator::operator ->() const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::operator ->");
+  if (!can_erase || current < 0)
+    throw IteratorPositionIllegal("AddressablePriorityQueue::Iterator::operator -> Iterator illegal: exhausted");
+
+  return &ref_pq->values[ref_pq->heap[current]];
+}
+
+template<class T>
+auto AddressablePriorityQueue<T>::Iterator::handle() const -> Handle {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("AddressablePriorityQueue::Iterator::handle");
+  if (!can_erase || current < 0)
+    throw IteratorPositionIllegal("AddressablePriorityQueue::Iterator::handle Iterator illegal: exhausted");
+
+  int slot = ref_pq->heap[current];
+  return Handle(slot,ref_pq->generation[slot]);
+}
+
+
+template<class T>
+bool AddressablePriorityQueue<T>::Iterator::before(int a, int b) const {
+  return ref_pq->higher(a,b);
+}
+
+
+//After an erase, erase has already updated the frontier
+template<class T>
+void AddressablePriorityQueue<T>::Iterator::advance() {
+  if (current < 0)
+    return;
+
+  if (can_erase)
+    push_children(current);
+  current = pop_frontier();
+  can_erase = true;
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::Iterator::push_children(int i) {
+  for (int c = ref_pq->left_child(i); c <= ref_pq->right_child(i); ++c)
+    if (ref_pq->in_heap(c))
+      push_frontier(c);
+}
+
+
+template<class T>
+void AddressablePriorityQueue<T>::Iterator::push_frontier(int i) {
+  if (frontier_used == frontier_length) {
+    frontier_length = std::max(4,2*frontier_length);
+    int* old_frontier = frontier;
+    frontier = new int[frontier_length];
+    for (int f=0; f<frontier_used; ++f)
+      frontier[f] = old_frontier[f];
+    delete[] old_frontier;
+  }
+
+  int f = frontier_used++;
+  for (/*See above*/; f > 0 && before(i,frontier[(f-1)/2]); f = (f-1)/2)
+    frontier[f] = frontier[(f-1)/2];
+  frontier[f] = i;
+}
+
+
+template<class T>
+int AddressablePriorityQueue<T>::Iterator::pop_frontier() {
+  if (frontier_used == 0)
+    return -1;
+
+  int answer = frontier[0];
+  int moved  = frontier[--frontier_used];
+  int f = 0;
+  for (int l = 1; l < frontier_used; l = 2*f+1) {
+    int max = l+1 < frontier_used && before(frontier[l+1],frontier[l]) ? l+1 : l;
+    if (!before(frontier[max],moved))
+      break;
+    frontier[f] = frontier[max];
+    f = max;
+  }
+  frontier[f] = moved;
+  return answer;
+}
+
+
+//Only erase removes from inside the frontier (rarely): rebuild it without i
+template<class T>
+void AddressablePriorityQueue<T>::Iterator::erase_frontier(int i) {
+  int old_used = frontier_used;
+  frontier_used = 0;
+  for (int f=0; f<old_used; ++f)
+    if (frontier[f] != i)
+      push_frontier(frontier[f]);
+}
+
+
+//Position i was visited iff it is current, or its parent was visited and
+//  then expanded (is not current) and i is no longer in the frontier
+template<class T>
+bool AddressablePriorityQueue<T>::Iterator::visited(int i) const {
+  if (i == current || ref_pq->is_root(i))
+    return true;
+  int p = ref_pq->parent(i);
+  if (p == current || !visited(p))
+    return false;
+  for (int f=0; f<frontier_used; ++f)
+    if (frontier[f] == i)
+      return false;
+  return true;
+}
+
+}
+
+#endif /* ADDRESSABLE_PRIORITY_QUEUE_HPP_ */
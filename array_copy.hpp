@@ -0,0 +1,57 @@
+#ifndef ARRAY_COPY_HPP_
+#define ARRAY_COPY_HPP_
+
+#include <cstring>
+#include <utility>
+#include <type_traits>
+
+
+namespace ics {
+
+//Copy/move the first n values of one array (allocated by new T[...]) into
+//  another: one memcpy for trivially copyable T (e.g., int, or ics::pair
+//  of such types), otherwise value by value with T's =.
+
+
+namespace array_copy {
+
+template<class T>
+void copy (T* to, const T* from, int n, std::true_type) {
+  if (n > 0)
+    std::memcpy(static_cast<void*>(to),static_cast<const void*>(from),n*sizeof(T));
+}
+
+template<class T>
+void copy (T* to, const T* from, int n, std::false_type) {
+  for (int i=0; i<n; ++i)
+    to[i] = from[i];
+}
+
+//Moving a trivially copyable value is copying it
+template<class T>
+void move (T* to, T* from, int n, std::true_type) {
+  array_copy::copy(to,from,n,std::true_type());
+}
+
+template<class T>
+void move (T* to, T* from, int n, std::false_type) {
+  for (int i=0; i<n; ++i)
+    to[i] = std::move(from[i]);
+}
+
+}
+
+
+template<class T>
+inline void copy_array (T* to, const T* from, int n) {
+  array_copy::copy(to,from,n,std::is_trivially_copyable<T>());
+}
+
+template<class T>
+inline void move_array (T* to, T* from, int n) {
+  array_copy::move(to,from,n,std::is_trivially_copyable<T>());
+}
+
+}
+
+#endif /* ARRAY_COPY_HPP_ */
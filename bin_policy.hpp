@@ -0,0 +1,72 @@
+#ifndef BIN_POLICY_HPP_
+#define BIN_POLICY_HPP_
+
+#include <cstddef>
+#include <cstdint>
+
+
+namespace ics {
+
+//A bin policy decides how many bins a chained hash table (HashMap, HashSet)
+//  may have and how a hash code is compressed into one of them:
+//    round_bins(n)       -> the # of bins to use when asked for n (n >= 1)
+//    compress(code,bins) -> a bin index in [0,bins)
+//Tables only ever double their bins, so a count returned by round_bins
+//  stays valid for the life of the table.
+
+
+//Any # of bins; compress with %. An integer division on every lookup, but
+//  it uses every bit of the hash code (the original HashMap behavior).
+class ModuloBins {
+  public:
+    static int round_bins (int n)
+    {return n < 1 ? 1 : n;}
+
+    static int compress (std::size_t hash_code, int bins)
+    {return int(hash_code % std::size_t(bins));}
+};
+
+
+//Power-of-2 bins; compress by keeping the low bits of the hash code. The
+//  cheapest reduction, but only good for hash functions whose low bits are
+//  well distributed (e.g., std::hash<int> on keys that are not all multiples
+//  of a power of 2).
+class MaskBins {
+  public:
+    static int round_bins (int n)
+    {int b = 1; while (b < n) b <<= 1; return b;}
+
+    static int compress (std::size_t hash_code, int bins)
+    {return int(hash_code & std::size_t(bins-1));}
+};
+
+
+//Power-of-2 bins; compress by Fibonacci hashing: multiply by 2^64/phi and
+//  keep the high bits of the product, which depend on every bit of the hash
+//  code. Almost as cheap as MaskBins and safe for weak (e.g., identity) hashes.
+class FibonacciBins {
+  public:
+    static int round_bins (int n)
+    {return MaskBins::round_bins(n);}
+
+    static int compress (std::size_t hash_code, int bins) {
+      std::uint64_t h = std::uint64_t(hash_code) * 0x9E3779B97F4A7C15ULL;
+      return int((h >> (63-log2(bins))) >> 1);  //2 shifts: bins may be 1
+    }
+
+  private:
+    static int log2 (int bins) {
+#if defined(__GNUC__)
+      return __builtin_ctz(unsigned(bins));
+#else
+      int answer = 0;
+      for (; bins > 1; bins >>= 1)
+        ++answer;
+      return answer;
+#endif
+    }
+};
+
+}
+
+#endif /* BIN_POLICY_HPP_ */
@@ -0,0 +1,614 @@
+#ifndef BUCKET_PRIORITY_QUEUE_HPP_
+#define BUCKET_PRIORITY_QUEUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>              //For std::swap function
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "priority_queue.hpp"
+#include "array_stack.hpp"
+#include "node_pool.hpp"
+
+
+namespace ics {
+
+//Default PRIORITY for BucketPriorityQueue: the value itself (e.g., for int)
+template<class T>
+class ValuePriority {
+  public:
+    int operator () (const T& v) const {return int(v);}
+};
+
+
+//A priority queue for values with small integer priorities: PRIORITY()(v) is
+//  v's priority, and values with bigger priorities are dequeued first (values
+//  with equal priorities are dequeued in the order they were enqueued).
+//Each priority has a bucket (a linked list); enqueue is O(1) and dequeue is
+//  O(1) amortized: after emptying the top bucket it scans down to the next
+//  non-empty one.
+//All priorities in the queue must be within span of each other: span buckets
+//  are reused circularly (priority p is in bucket p mod span), so a window of
+//  priorities can slide down over any range of ints. For example, use span 256
+//  for priorities 0..255; for timers or for Dial's shortest-path algorithm
+//  (edge weights at most C, span C+1), make PRIORITY the negated time/distance.
+//gt (for the base class) compares priorities, so PRIORITY must be a stateless
+//  function object.
+template<class T,class PRIORITY = ics::ValuePriority<T>> class BucketPriorityQueue : public PriorityQueue<T>  {
+  public:
+    explicit BucketPriorityQueue(int span = 256);
+    BucketPriorityQueue(const BucketPriorityQueue<T,PRIORITY>& to_copy);
+    BucketPriorityQueue(BucketPriorityQueue<T,PRIORITY>&& to_move);
+    BucketPriorityQueue(std::initializer_list<T> il, int span = 256);
+    BucketPriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop, int span = 256);
+    virtual ~BucketPriorityQueue();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual T&   peek       () const;
+    virtual std::string str () const;
+
+    virtual int  enqueue (const T& element);
+    virtual T    dequeue ();
+    virtual void clear   ();
+
+    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> enqueue (const ITERATOR& start, const ITERATOR& stop);
+
+    int  peek_priority () const;  //PRIORITY()(peek()), without recomputing it
+
+    virtual BucketPriorityQueue<T,PRIORITY>& operator = (const BucketPriorityQueue<T,PRIORITY>& rhs);
+    virtual BucketPriorityQueue<T,PRIORITY>& operator = (BucketPriorityQueue<T,PRIORITY>&& rhs);
+    virtual bool operator == (const PriorityQueue<T>& rhs) const;
+    virtual bool operator != (const PriorityQueue<T>& rhs) const;
+
+    template<class T2,class PRIORITY2>
+    friend std::ostream& operator << (std::ostream& outs, const BucketPriorityQueue<T2,PRIORITY2>& p);
+
+    virtual ics::Iterator<T>& ibegin() const;
+    virtual ics::Iterator<T>& iend  () const;
+
+  private:
+    class LN;
+
+  public:
+    //Iterators visit values in priority order (highest first): bucket by
+    //  bucket, from top down to bottom
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(BucketPriorityQueue<T,PRIORITY>* iterate_over, bool begin);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        BucketPriorityQueue<T,PRIORITY>* ref_pq;
+        int  at;                  //Priority of current's bucket
+        LN*  prev    = nullptr;   //Node before current in its bucket (nullptr if first)
+        LN*  current = nullptr;   //nullptr when exhausted
+        int  expected_mod_count;
+        bool can_erase = true;
+        void find_bucket ();      //Starting at bucket at, find the next value
+    };
+
+    virtual Iterator begin() const;
+    virtual Iterator end  () const;
+
+  private:
+    class LN {
+      public:
+        LN ()                      : next(nullptr) {}
+        LN (const LN& ln)          : value(ln.value), next(ln.next) {}
+        LN (T v, LN* n = nullptr)  : value(std::move(v)), next(n) {}
+
+        T   value;
+        LN* next;
+    };
+
+    class Bucket {
+      public:
+        LN* front = nullptr;
+        LN* rear  = nullptr;
+    };
+
+    static bool higher (const T& a, const T& b) {PRIORITY p; return p(a) > p(b);}
+
+    //See base class PriorityQueue
+    //bool (*gt)(const T& a, const T& b);// gt(a,b) = true iff a has higher priority than b
+    Bucket*        buckets;
+    int            span;
+    int            used      = 0;    //# values in the queue
+    int            top       = 0;    //Highest priority in the queue (if not empty)
+    int            bottom    = 0;    //No priority in the queue is lower (if not empty)
+    int            mod_count = 0;    //For sensing concurrent modification
+    ics::NodePool<LN> pool;
+    PRIORITY       priority;
+    Bucket& bucket_of  (int p) const; //Bucket for priority p
+    void    append     (Bucket& b, const T& element);
+    void    unlink     (Bucket& b, LN* prev, LN* to_unlink);
+    void    find_bounds();            //Lower top/raise bottom to the highest/lowest non-empty buckets
+    void    delete_list(LN*& front);  //Deallocate all LNs in one bucket
+  };
+
+
+
+
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::BucketPriorityQueue(int span)
+  : PriorityQueue<T>(higher), span(span) {
+  if (span < 1)
+    throw IcsError("BucketPriorityQueue::constructor: span("+std::to_string(span)+") < 1");
+  buckets = new Bucket[span];
+}
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::BucketPriorityQueue(const BucketPriorityQueue<T,PRIORITY>& to_copy)
+  : BucketPriorityQueue<T,PRIORITY>(to_copy.span) {
+  pool.reserve(to_copy.used);
+  for (int b=0; b<span; ++b)
+    for (LN* n = to_copy.buckets[b].front; n != nullptr; n = n->next)
+      append(buckets[b],n->value);
+  used   = to_copy.used;
+  top    = to_copy.top;
+  bottom = to_copy.bottom;
+}
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::BucketPriorityQueue(BucketPriorityQueue<T,PRIORITY>&& to_move)
+  : BucketPriorityQueue<T,PRIORITY>(to_move.span) {
+  *this = std::move(to_move);
+}
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::BucketPriorityQueue(std::initializer_list<T> il, int span)
+  : BucketPriorityQueue<T,PRIORITY>(span) {
+  pool.reserve(il.size());
+  for (const T& pq_elem : il)
+    enqueue(pq_elem);
+}
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::BucketPriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop, int span)
+  : BucketPriorityQueue<T,PRIORITY>(span) {
+  enqueue(start,stop);
+}
+
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::~BucketPriorityQueue() {
+  for (int b=0; b<span; ++b)
+    delete_list(buckets[b].front);
+  delete[] buckets;
+}
+
+
+template<class T,class PRIORITY>
+inline bool BucketPriorityQueue<T,PRIORITY>::empty() const {
+  return used == 0;
+}
+
+template<class T,class PRIORITY>
+int BucketPriorityQueue<T,PRIORITY>::size() const {
+  return used;
+}
+
+template<class T,class PRIORITY>
+T& BucketPriorityQueue<T,PRIORITY>::peek () const {
+  if (empty())
+    throw EmptyError("BucketPriorityQueue::peek");
+
+  return bucket_of(top).front->value;
+}
+
+template<class T,class PRIORITY>
+int BucketPriorityQueue<T,PRIORITY>::peek_priority () const {
+  if (empty())
+    throw EmptyError("BucketPriorityQueue::peek_priority");
+
+  return top;
+}
+
+template<class T,class PRIORITY>
+std::string BucketPriorityQueue<T,PRIORITY>::str() const {
+  std::ostringstream answer;
+  answer << "priority_queue[";
+  if (!empty()) {
+    bool first = true;
+    for (int p = top; p >= bottom; --p) {
+      const Bucket& b = bucket_of(p);
+      if (b.front == nullptr)
+        continue;
+      answer << (first ? "" : ",") << p << ":[";
+      for (LN* n = b.front; n != nullptr; n = n->next)
+        answer << (n == b.front ? "" : ",") << n->value;
+      answer << "]";
+      first = false;
+    }
+  }
+  answer << "](span=" << span << ",used=" << used << ",top=" << top << ",bottom=" << bottom
+         << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+template<class T,class PRIORITY>
+int BucketPriorityQueue<T,PRIORITY>::enqueue(const T& element) {
+  int p = priority(element);
+  if (empty())
+    top = bottom = p;
+  else {
+    int new_top    = p > top    ? p : top;
+    int new_bottom = p < bottom ? p : bottom;
+    if ((long long)new_top - new_bottom >= span)
+      throw IcsError("BucketPriorityQueue::enqueue: priority("+std::to_string(p)+") not within span("+
+                     std::to_string(span)+") of priorities in ["+std::to_string(bottom)+","+std::to_string(top)+"]");
+    top    = new_top;
+    bottom = new_bottom;
+  }
+
+  append(bucket_of(p),element);
+  ++used;
+  ++mod_count;
+  return 1;
+}
+
+template<class T,class PRIORITY>
+T BucketPriorityQueue<T,PRIORITY>::dequeue() {
+  if (this->empty())
+    throw EmptyError("BucketPriorityQueue::dequeue");
+
+  Bucket& b = bucket_of(top);
+  LN* to_delete = b.front;
+  T to_return = std::move(to_delete->value);
+  unlink(b,nullptr,to_delete);
+  find_bounds();
+  ++mod_count;
+  return to_return;
+}
+
+template<class T,class PRIORITY>
+void BucketPriorityQueue<T,PRIORITY>::clear() {
+  for (int b=0; b<span; ++b)
+    delete_list(buckets[b].front);
+  used = 0;
+  ++mod_count;
+}
+
+template<class T,class PRIORITY>
+int BucketPriorityQueue<T,PRIORITY>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += enqueue(*start);
+
+  return count;
+}
+
+
+template<class T,class PRIORITY>
+template<class ITERATOR>
+auto BucketPriorityQueue<T,PRIORITY>::enqueue (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i)
+    count += enqueue(*i);
+
+  return count;
+}
+
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>& BucketPriorityQueue<T,PRIORITY>::operator = (const BucketPriorityQueue<T,PRIORITY>& rhs) {
+  if (this == &rhs)
+    return *this;
+  BucketPriorityQueue<T,PRIORITY> copy(rhs);
+  *this = std::move(copy);
+  return *this;
+}
+
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>& BucketPriorityQueue<T,PRIORITY>::operator = (BucketPriorityQueue<T,PRIORITY>&& rhs) {
+  std::swap(buckets,rhs.buckets);  //rhs gets (and later deletes) the old buckets
+  std::swap(span,   rhs.span);
+  std::swap(used,   rhs.used);
+  std::swap(top,    rhs.top);
+  std::swap(bottom, rhs.bottom);
+  pool.swap(rhs.pool);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+template<class T,class PRIORITY>
+bool BucketPriorityQueue<T,PRIORITY>::operator == (const PriorityQueue<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+  const BucketPriorityQueue<T,PRIORITY>* rhsBPQ = dynamic_cast<const BucketPriorityQueue<T,PRIORITY>*>(&rhs);
+  if (rhsBPQ != nullptr) {
+    for (Iterator l = begin(), r = rhsBPQ->begin(); l != end(); ++l, ++r)
+      if (*l != *r)
+        return false;
+    return true;
+  }
+
+  bool answer = true;
+  ics::Iterator<T>& r = rhs.ibegin();
+  for (Iterator l = begin(); answer && l != end(); ++l, ++r)
+    answer = !(*l != *r);
+  delete &r;  //ibegin returns a heap-allocated iterator
+  return answer;
+}
+
+template<class T,class PRIORITY>
+bool BucketPriorityQueue<T,PRIORITY>::operator != (const PriorityQueue<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+template<class T,class PRIORITY>
+std::ostream& operator << (std::ostream& outs, const BucketPriorityQueue<T,PRIORITY>& p) {
+  if (p.empty()) {
+    outs << "priority_queue[]";
+  }else{
+    outs << "priority_queue[";
+    ArrayStack<const T*> temp(p.used);
+    for (const T& v : p)
+      temp.push(&v);
+    for (int i=0; i<p.used-1; ++i)
+      outs << *temp.pop() << ",";
+    outs << *temp.pop() << "]:highest";
+  }
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T,class PRIORITY>
+auto BucketPriorityQueue<T,PRIORITY>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<BucketPriorityQueue<T,PRIORITY>*>(this),true));
+}
+
+//KLUDGE: memory-leak
+template<class T,class PRIORITY>
+auto BucketPriorityQueue<T,PRIORITY>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<BucketPriorityQueue<T,PRIORITY>*>(this),false));
+}
+
+template<class T,class PRIORITY>
+auto BucketPriorityQueue<T,PRIORITY>::begin () const -> BucketPriorityQueue<T,PRIORITY>::Iterator {
+  return Iterator(const_cast<BucketPriorityQueue<T,PRIORITY>*>(this),true);
+}
+
+template<class T,class PRIORITY>
+auto BucketPriorityQueue<T,PRIORITY>::end () const -> BucketPriorityQueue<T,PRIORITY>::Iterator {
+  return Iterator(const_cast<BucketPriorityQueue<T,PRIORITY>*>(this),false);
+}
+
+
+//p mod span, rounded toward negative infinity (priorities may be negative)
+template<class T,class PRIORITY>
+auto BucketPriorityQueue<T,PRIORITY>::bucket_of(int p) const -> Bucket& {
+  int b = p % span;
+  return buckets[b < 0 ? b+span : b];
+}
+
+
+template<class T,class PRIORITY>
+void BucketPriorityQueue<T,PRIORITY>::append(Bucket& b, const T& element) {
+  LN* n = pool.make(element);
+  if (b.front == nullptr)
+    b.front = n;
+  else
+    b.rear->next = n;
+  b.rear = n;
+}
+
+
+template<class T,class PRIORITY>
+void BucketPriorityQueue<T,PRIORITY>::unlink(Bucket& b, LN* prev, LN* to_unlink) {
+  (prev == nullptr ? b.front : prev->next) = to_unlink->next;
+  if (b.rear == to_unlink)
+    b.rear = prev;
+  pool.release(to_unlink);
+  --used;
+}
+
+
+//Each step down (up) is paid for by the enqueue that raised top (lowered
+//  bottom), or set it when the queue was empty, so scanning is O(1)
+//  amortized. Raising bottom after erasing its last value keeps the span
+//  check in enqueue to the priorities actually in the queue.
+template<class T,class PRIORITY>
+void BucketPriorityQueue<T,PRIORITY>::find_bounds() {
+  if (empty())
+    return;
+  while (bucket_of(top).front == nullptr)
+    --top;
+  while (bucket_of(bottom).front == nullptr)
+    ++bottom;
+}
+
+
+template<class T,class PRIORITY>
+void BucketPriorityQueue<T,PRIORITY>::delete_list(LN*& front) {
+  for (LN* n = front; n != nullptr; /*See body*/) {
+    LN* to_delete = n;
+    n = n->next;
+    pool.release(to_delete);
+  }
+  front = nullptr;
+}
+
+
+
+
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::Iterator::Iterator(BucketPriorityQueue<T,PRIORITY>* iterate_over, bool begin)
+  : ref_pq(iterate_over), at(iterate_over->top) {
+  expected_mod_count = ref_pq->mod_count;
+  if (begin && !ref_pq->empty())
+    find_bucket();
+}
+
+template<class T,class PRIORITY>
+BucketPriorityQueue<T,PRIORITY>::Iterator::~Iterator() {}
+
+//current becomes the value after the erased one, but operator ++ will not advance past it
+template<class T,class PRIORITY>
+T BucketPriorityQueue<T,PRIORITY>::Iterator::erase() {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("BucketPriorityQueue::Iterator::erase Iterator cursor already erased");
+  if (current == nullptr)
+    throw CannotEraseError("BucketPriorityQueue::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  LN* to_erase = current;
+  T to_return = std::move(to_erase->value);
+  current = to_erase->next;
+  ref_pq->unlink(ref_pq->bucket_of(at),prev,to_erase);
+  if (current == nullptr) {
+    --at;
+    prev = nullptr;
+    find_bucket();
+  }
+  ref_pq->find_bounds();
+
+  ++ref_pq->mod_count;
+  expected_mod_count = ref_pq->mod_count;
+  return to_return;
+}
+
+template<class T,class PRIORITY>
+std::string BucketPriorityQueue<T,PRIORITY>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_pq->str() << "/at=" << at << "/current=";
+  if (current == nullptr)
+    answer << "end";
+  else
+    answer << current->value;
+  answer << "/expected_mod_count=" << expected_mod_count << "/can_erase=" << can_erase;
+  return answer.str();
+}
+
+
+template<class T,class PRIORITY>
+const ics::Iterator<T>& BucketPriorityQueue<T,PRIORITY>::Iterator::operator ++ () {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::operator ++");
+
+  if (current == nullptr)
+    return *this;
+
+  if (can_erase) {
+    prev    = current;
+    current = current->next;
+    if (current == nullptr) {
+      --at;
+      prev = nullptr;
+      find_bucket();
+    }
+  }
+  else
+    can_erase = true;  //current already stores the next value after the erased one
+  return *this;
+}
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T,class PRIORITY>
+const ics::Iterator<T>& BucketPriorityQueue<T,PRIORITY>::Iterator::operator ++ (int) {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::operator ++(int)");
+
+  if (current == nullptr)
+    return *this;
+
+  Iterator* to_return = new Iterator(*this);
+  ++(*this);
+  return *to_return;
+}
+
+template<class T,class PRIORITY>
+bool BucketPriorityQueue<T,PRIORITY>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("BucketPriorityQueue::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T,class PRIORITY>
+bool BucketPriorityQueue<T,PRIORITY>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::operator ==");
+  if (ref_pq != rhs.ref_pq)
+    throw ComparingDifferentIteratorsError("BucketPriorityQueue::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class T,class PRIORITY>
+bool BucketPriorityQueue<T,PRIORITY>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("BucketPriorityQueue::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T,class PRIORITY>
+bool BucketPriorityQueue<T,PRIORITY>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::operator !=");
+  if (ref_pq != rhs.ref_pq)
+    throw ComparingDifferentIteratorsError("BucketPriorityQueue::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+template<class T,class PRIORITY>
+T& BucketPriorityQueue<T,PRIORITY>::Iterator::operator *() const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::operator *");
+  if (!can_erase || current == nullptr)
+    throw IteratorPositionIllegal("BucketPriorityQueue::Iterator::operator * Iterator illegal: exhausted");
+
+  return current->value;
+}
+
+template<class T,class PRIORITY>
+T* BucketPriorityQueue<T,PRIORITY>::Iterator::operator ->() const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("BucketPriorityQueue::Iterator::operator ->");
+  if (!can_erase || current == nullptr)
+    throw IteratorPositionIllegal("BucketPriorityQueue::Iterator::operator -> Iterator illegal: exhausted");
+
+  return &current->value;
+}
+
+
+template<class T,class PRIORITY>
+void BucketPriorityQueue<T,PRIORITY>::Iterator::find_bucket() {
+  for (/*See at*/; at >= ref_pq->bottom; --at)
+    if ( (current = ref_pq->bucket_of(at).front) != nullptr )
+      return;
+  current = nullptr;
+}
+
+}
+
+#endif /* BUCKET_PRIORITY_QUEUE_HPP_ */
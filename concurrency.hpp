@@ -0,0 +1,112 @@
+#ifndef CONCURRENCY_HPP_
+#define CONCURRENCY_HPP_
+
+#include <atomic>
+#include <thread>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace ics {
+
+//Shared by the data structures that are safe to use from more than one
+//  thread (e.g., SPSCQueue, MPMCQueue, ConcurrentHashMap).
+
+//Values written by different threads are kept at least this many bytes
+//  apart, so they are never on the same cache line: otherwise each write
+//  would invalidate the line in the other thread's cache ("false sharing").
+//  (C++17's std::hardware_destructive_interference_size, for C++11)
+const int CACHE_LINE_SIZE = 64;
+
+
+//For waiting (e.g., until a queue is no longer full/empty) by retrying:
+//  call pause() after each failed try. The first pauses spin, twice as long
+//  each time (retrying soon, without giving up the core); later pauses
+//  yield the core to another thread.
+class Backoff {
+  public:
+    void pause () {
+      if (spins > SPIN_LIMIT) {
+        std::this_thread::yield();
+        return;
+      }
+      for (int i=0; i<spins; ++i)
+        relax();
+      spins *= 2;
+    }
+
+    void reset () {spins = 1;}
+
+  private:
+    static const int SPIN_LIMIT = 64;
+    int spins = 1;
+
+    //Tells the CPU this is a spin loop (saving power, and not penalizing the
+    //  loop's exit with a pipeline flush)
+    static void relax () {
+#if defined(__SSE2__)
+      _mm_pause();
+#endif
+    }
+};
+
+
+//A reader-writer lock (C++11 has no std::shared_mutex) for short critical
+//  sections: any number of threads may hold it shared (lock_shared), or one
+//  may hold it exclusively (lock); waiting threads spin/yield (see Backoff)
+//  rather than sleeping. A waiting writer stops new readers from entering,
+//  so a steady stream of readers cannot starve it.
+//lock/unlock make it usable with std::lock_guard; use SharedGuard for reads.
+class ReadWriteLock {
+  public:
+    void lock_shared () {
+      Backoff backoff;
+      for (;;) {
+        int s = state.load(std::memory_order_relaxed);
+        if ((s & (WRITER | WRITER_WAITING)) == 0 &&
+            state.compare_exchange_weak(s,s+1,std::memory_order_acquire,std::memory_order_relaxed))
+          return;
+        backoff.pause();
+      }
+    }
+
+    void unlock_shared () {state.fetch_sub(1,std::memory_order_release);}
+
+    //Taking the lock clears WRITER_WAITING; any other waiting writer sets it again
+    void lock () {
+      Backoff backoff;
+      for (;;) {
+        int s = state.load(std::memory_order_relaxed);
+        if ((s & ~WRITER_WAITING) == 0) {
+          if (state.compare_exchange_weak(s,WRITER,std::memory_order_acquire,std::memory_order_relaxed))
+            return;
+        }else if ((s & WRITER_WAITING) == 0)
+          state.fetch_or(WRITER_WAITING,std::memory_order_relaxed);
+        backoff.pause();
+      }
+    }
+
+    void unlock () {state.fetch_and(~WRITER,std::memory_order_release);}
+
+  private:
+    static const int WRITER         = 1 << 30;
+    static const int WRITER_WAITING = 1 << 29;
+    std::atomic<int> state{0};  //The bits above, plus the # of readers
+};
+
+
+//Holds a ReadWriteLock shared for its lifetime (like std::lock_guard)
+class SharedGuard {
+  public:
+    explicit SharedGuard(ReadWriteLock& to_lock) : lock(to_lock) {lock.lock_shared();}
+    SharedGuard(const SharedGuard& to_copy) = delete;
+    SharedGuard& operator = (const SharedGuard& rhs) = delete;
+    ~SharedGuard() {lock.unlock_shared();}
+  private:
+    ReadWriteLock& lock;
+};
+
+}
+
+#endif /* CONCURRENCY_HPP_ */
@@ -0,0 +1,574 @@
+#ifndef CONCURRENT_HASH_MAP_HPP_
+#define CONCURRENT_HASH_MAP_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <functional>
+#include <mutex>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "concurrency.hpp"
+#include "bin_policy.hpp"
+#include "pair.hpp"
+#include "map.hpp"
+#include "hash_map.hpp"
+
+
+namespace ics {
+
+//A Map shared by any number of threads: the keys are partitioned into
+//  shards (a power of 2 of them), each a HashMap guarded by its own
+//  ReadWriteLock, so threads using keys in different shards never wait for
+//  each other, and threads only reading (has_key, get, ...) never wait for
+//  each other at all. A key's shard is chosen by the high bits of its hash
+//  code (see FibonacciBins), independent of the bin its shard's HashMap
+//  chooses from the (low) bits.
+//
+//empty/size/has_key/has_value/get/try_get/put/put_if_absent/erase/clear/
+//  update/compute are safe from any thread. Each is atomic for its key
+//  (has_value, size, and clear go shard by shard, so are not atomic for the
+//  whole map). Lambdas passed to update/compute run holding their key's
+//  shard's lock: they must be short, and must not use this map.
+//operator [] returns a reference to the value in the map: it is safe to use
+//  only while no other thread erases that key or writes that value; prefer
+//  get/put/update/compute. All other operations (copying, assignment, ==,
+//  str, <<, iterators) must be used only when no other thread is using the map.
+template<class KEY,class T,class HASH = std::hash<KEY>,class EQUALS = std::equal_to<KEY>>
+class ConcurrentHashMap : public Map<KEY,T>	{
+  public:
+    typedef ics::pair<KEY,T> Entry;
+    typedef HashMap<KEY,T,HASH,EQUALS> ShardMap;
+    explicit ConcurrentHashMap(int shard_count = 64, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());  //Rounded up to a power of 2
+    ConcurrentHashMap(const ConcurrentHashMap<KEY,T,HASH,EQUALS>& to_copy);
+    ConcurrentHashMap(ConcurrentHashMap<KEY,T,HASH,EQUALS>&& to_move);
+    ConcurrentHashMap(std::initializer_list<Entry> il, int shard_count = 64, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());
+    ConcurrentHashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, int shard_count = 64, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());
+    virtual ~ConcurrentHashMap();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual bool has_key    (const KEY& key) const;
+    virtual bool has_value  (const T& value) const;
+    virtual std::string str () const;
+    int shard_count         () const;
+
+    T    get     (const KEY& key) const;            //A copy of key's value; throws KeyError if absent
+    bool try_get (const KEY& key, T& into) const;   //false (and into unchanged) if absent
+
+    virtual T    put   (const KEY& key, const T& value);
+    virtual T    erase (const KEY& key);
+    virtual void clear ();
+
+    //Put key->value if key is absent; returns whether it did
+    bool put_if_absent (const KEY& key, const T& value);
+
+    //f(T& value) updates key's value in place: update calls it only if key
+    //  is present (and returns whether it was); compute first puts key->T()
+    //  if key is absent, and returns a copy of the updated value
+    //  e.g., counting words: counts.compute(word, [](int& c){++c;});
+    template<class F>
+    bool update  (const KEY& key, F f);
+    template<class F>
+    T    compute (const KEY& key, F f);
+
+    virtual int put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,Entry> put (const ITERATOR& start, const ITERATOR& stop);
+
+    virtual T&       operator [] (const KEY&);
+    virtual const T& operator [] (const KEY&) const;
+    virtual ConcurrentHashMap<KEY,T,HASH,EQUALS>& operator = (const ConcurrentHashMap<KEY,T,HASH,EQUALS>& rhs);
+    virtual ConcurrentHashMap<KEY,T,HASH,EQUALS>& operator = (ConcurrentHashMap<KEY,T,HASH,EQUALS>&& rhs);
+    virtual bool operator == (const Map<KEY,T>& rhs) const;
+    virtual bool operator != (const Map<KEY,T>& rhs) const;
+
+    template<class KEY2,class T2,class HASH2,class EQUALS2>
+    friend std::ostream& operator << (std::ostream& outs, const ConcurrentHashMap<KEY2,T2,HASH2,EQUALS2>& m);
+
+    virtual ics::Iterator<Entry>& ibegin () const;
+    virtual ics::Iterator<Entry>& iend   () const;
+
+    //Iterates through each shard's HashMap in turn; senses concurrent
+    //  modification (of the shard it is in) through that HashMap's Iterator
+    class Iterator final : public ics::Iterator<Entry> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(ConcurrentHashMap<KEY,T,HASH,EQUALS>* iterate_over, bool begin);
+        virtual ~Iterator();
+        virtual Entry       erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<Entry>& operator ++ ();
+        virtual const ics::Iterator<Entry>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<Entry>& rhs) const;
+        virtual bool operator != (const ics::Iterator<Entry>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual Entry& operator *  () const;
+        virtual Entry* operator -> () const;
+      private:
+        int                                    shard;    //Index of the shard current is in
+        typename ShardMap::Iterator            current;
+        ConcurrentHashMap<KEY,T,HASH,EQUALS>*  ref_map;
+        void skip_empty_shards ();
+    };
+
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    //The padding keeps each shard's (often written) lock on its own cache line
+    class Shard {
+      public:
+        mutable ReadWriteLock lock;
+        ShardMap              map;
+        char                  pad[CACHE_LINE_SIZE];
+    };
+
+    Shard* shards;
+    int    shards_length;
+    HASH   hash;
+    EQUALS equals;
+    Shard&       shard_of (const KEY& key)       {return shards[FibonacciBins::compress(hash(key),shards_length)];}
+    const Shard& shard_of (const KEY& key) const {return shards[FibonacciBins::compress(hash(key),shards_length)];}
+    void make_shards (int shard_count);
+  };
+
+
+
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::ConcurrentHashMap(int shard_count, const HASH& ahash, const EQUALS& aequals) : hash(ahash), equals(aequals) {
+  make_shards(shard_count);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::ConcurrentHashMap(const ConcurrentHashMap<KEY,T,HASH,EQUALS>& to_copy)
+  : hash(to_copy.hash), equals(to_copy.equals) {
+  make_shards(to_copy.shards_length);
+  for (int s=0; s<shards_length; ++s)
+    shards[s].map = to_copy.shards[s].map;
+}
+
+
+//to_move is left empty, with one (new) shard
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::ConcurrentHashMap(ConcurrentHashMap<KEY,T,HASH,EQUALS>&& to_move)
+  : ConcurrentHashMap<KEY,T,HASH,EQUALS>(1,to_move.hash,to_move.equals) {
+  *this = std::move(to_move);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::ConcurrentHashMap(std::initializer_list<Entry> il, int shard_count, const HASH& ahash, const EQUALS& aequals)
+  : ConcurrentHashMap<KEY,T,HASH,EQUALS>(shard_count,ahash,aequals) {
+  for (const Entry& m_entry : il)
+    put(m_entry.first,m_entry.second);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::ConcurrentHashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, int shard_count, const HASH& ahash, const EQUALS& aequals)
+  : ConcurrentHashMap<KEY,T,HASH,EQUALS>(shard_count,ahash,aequals) {
+  put(start,stop);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::~ConcurrentHashMap() {
+  delete[] shards;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::empty() const {
+  for (int s=0; s<shards_length; ++s) {
+    SharedGuard guard(shards[s].lock);
+    if (!shards[s].map.empty())
+      return false;
+  }
+  return true;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+int ConcurrentHashMap<KEY,T,HASH,EQUALS>::size() const {
+  int answer = 0;
+  for (int s=0; s<shards_length; ++s) {
+    SharedGuard guard(shards[s].lock);
+    answer += shards[s].map.size();
+  }
+  return answer;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::has_key (const KEY& key) const {
+  const Shard& s = shard_of(key);
+  SharedGuard guard(s.lock);
+  return s.map.has_key(key);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::has_value (const T& value) const {
+  for (int s=0; s<shards_length; ++s) {
+    SharedGuard guard(shards[s].lock);
+    if (shards[s].map.has_value(value))
+      return true;
+  }
+  return false;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::string ConcurrentHashMap<KEY,T,HASH,EQUALS>::str() const {
+  std::ostringstream answer;
+  answer << "ConcurrentHashMap[";
+  for (int s=0; s<shards_length; ++s)
+    answer << std::endl << "shard[" << s << "] = " << shards[s].map;
+  answer << "](shards=" << shards_length << ",size=" << size() << ")";
+  return answer.str();
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+int ConcurrentHashMap<KEY,T,HASH,EQUALS>::shard_count() const {
+  return shards_length;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+T ConcurrentHashMap<KEY,T,HASH,EQUALS>::get (const KEY& key) const {
+  T answer;
+  if (!try_get(key,answer)) {
+    std::ostringstream where;
+    where << "ConcurrentHashMap::get: key(" << key << ") not in Map";
+    throw KeyError(where.str());
+  }
+  return answer;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::try_get (const KEY& key, T& into) const {
+  const Shard& s = shard_of(key);
+  SharedGuard guard(s.lock);
+  if (!s.map.has_key(key))
+    return false;
+  into = s.map[key];
+  return true;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+T ConcurrentHashMap<KEY,T,HASH,EQUALS>::put(const KEY& key, const T& value) {
+  Shard& s = shard_of(key);
+  std::lock_guard<ReadWriteLock> guard(s.lock);
+  return s.map.put(key,value);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+T ConcurrentHashMap<KEY,T,HASH,EQUALS>::erase(const KEY& key) {
+  Shard& s = shard_of(key);
+  std::lock_guard<ReadWriteLock> guard(s.lock);
+  return s.map.erase(key);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+void ConcurrentHashMap<KEY,T,HASH,EQUALS>::clear() {
+  for (int s=0; s<shards_length; ++s) {
+    std::lock_guard<ReadWriteLock> guard(shards[s].lock);
+    shards[s].map.clear();
+  }
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::put_if_absent (const KEY& key, const T& value) {
+  Shard& s = shard_of(key);
+  std::lock_guard<ReadWriteLock> guard(s.lock);
+  if (s.map.has_key(key))
+    return false;
+  s.map.put(key,value);
+  return true;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class F>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::update (const KEY& key, F f) {
+  Shard& s = shard_of(key);
+  std::lock_guard<ReadWriteLock> guard(s.lock);
+  if (!s.map.has_key(key))
+    return false;
+  f(s.map[key]);
+  return true;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class F>
+T ConcurrentHashMap<KEY,T,HASH,EQUALS>::compute (const KEY& key, F f) {
+  Shard& s = shard_of(key);
+  std::lock_guard<ReadWriteLock> guard(s.lock);
+  T& value = s.map[key];
+  f(value);
+  return value;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+int ConcurrentHashMap<KEY,T,HASH,EQUALS>::put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop) {
+  int count = 0;
+  for (; start != stop; ++start) {
+    ++count;
+    put(start->first,start->second);
+  }
+
+  return count;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class ITERATOR>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::put (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,Entry> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i) {
+    ++count;
+    put(i->first,i->second);
+  }
+
+  return count;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+T& ConcurrentHashMap<KEY,T,HASH,EQUALS>::operator [] (const KEY& key) {
+  Shard& s = shard_of(key);
+  std::lock_guard<ReadWriteLock> guard(s.lock);
+  return s.map[key];
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+const T& ConcurrentHashMap<KEY,T,HASH,EQUALS>::operator [] (const KEY& key) const {
+  const Shard& s = shard_of(key);
+  SharedGuard guard(s.lock);
+  return s.map[key];
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>& ConcurrentHashMap<KEY,T,HASH,EQUALS>::operator = (const ConcurrentHashMap<KEY,T,HASH,EQUALS>& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  hash   = rhs.hash;
+  equals = rhs.equals;
+  if (shards_length != rhs.shards_length) {
+    delete[] shards;
+    make_shards(rhs.shards_length);
+  }
+  for (int s=0; s<shards_length; ++s)
+    shards[s].map = rhs.shards[s].map;
+  return *this;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>& ConcurrentHashMap<KEY,T,HASH,EQUALS>::operator = (ConcurrentHashMap<KEY,T,HASH,EQUALS>&& rhs) {
+  std::swap(shards,       rhs.shards);  //rhs gets (and later deletes) the old shards
+  std::swap(shards_length,rhs.shards_length);
+  std::swap(hash,         rhs.hash);
+  std::swap(equals,       rhs.equals);
+  return *this;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::operator == (const Map<KEY,T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (size() != rhs.size())
+    return false;
+
+  for (int s=0; s<shards_length; ++s)
+    for (const Entry& kv : shards[s].map)
+       if (!rhs.has_key(kv.first) || kv.second !=  rhs[kv.first])
+         return false;
+
+  return true;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::operator != (const Map<KEY,T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::ostream& operator << (std::ostream& outs, const ConcurrentHashMap<KEY,T,HASH,EQUALS>& m) {
+  outs << "map[";
+
+  bool first = true;
+  for (const ics::pair<KEY,T>& kv : m) {
+    outs << (first ? "" : ",") << kv.first << "->" << kv.second;
+    first = false;
+  }
+
+  outs << "]";
+  return outs;
+}
+
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::ibegin () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<ConcurrentHashMap<KEY,T,HASH,EQUALS>*>(this),true));
+}
+
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::iend () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<ConcurrentHashMap<KEY,T,HASH,EQUALS>*>(this),false));
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::begin () const -> ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator {
+  return Iterator(const_cast<ConcurrentHashMap<KEY,T,HASH,EQUALS>*>(this),true);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::end () const -> ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator {
+  return Iterator(const_cast<ConcurrentHashMap<KEY,T,HASH,EQUALS>*>(this),false);
+}
+
+
+//Each shard's HashMap gets its own copy of hash
+template<class KEY,class T,class HASH,class EQUALS>
+void ConcurrentHashMap<KEY,T,HASH,EQUALS>::make_shards(int shard_count) {
+  shards_length = FibonacciBins::round_bins(shard_count);
+  shards = new Shard[shards_length];
+  for (int s=0; s<shards_length; ++s)
+    shards[s].map = ShardMap(hash,equals);
+}
+
+
+
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::Iterator(ConcurrentHashMap<KEY,T,HASH,EQUALS>* iterate_over, bool begin)
+  : shard(begin ? 0 : iterate_over->shards_length-1),
+    current(begin ? iterate_over->shards[0].map.begin() : iterate_over->shards[iterate_over->shards_length-1].map.end()),
+    ref_map(iterate_over) {
+  skip_empty_shards();
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::~Iterator()
+{}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::erase() -> Entry {
+  return current.erase();
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::string ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_map->str() << "(shard=" << shard << ",current=" << current.str() << ")";
+  return answer.str();
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto  ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator ++ () -> const ics::Iterator<Entry>& {
+  ++current;
+  skip_empty_shards();
+  return *this;
+}
+
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class KEY,class T,class HASH,class EQUALS>
+auto  ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator ++ (int) -> const ics::Iterator<Entry>& {
+  Iterator* to_return = new Iterator(*this);
+  ++current;
+  skip_empty_shards();
+  return *to_return;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator == (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("ConcurrentHashMap::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator == (const Iterator& rhs) const {
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("ConcurrentHashMap::Iterator::operator ==");
+
+  return shard == rhs.shard && current == rhs.current;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator != (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("ConcurrentHashMap::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator != (const Iterator& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator *() const -> Entry& {
+  return *current;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::operator ->() const -> Entry* {
+  return &*current;
+}
+
+
+//At the end of a shard (but the last), go on to the next shard's first entry
+template<class KEY,class T,class HASH,class EQUALS>
+void ConcurrentHashMap<KEY,T,HASH,EQUALS>::Iterator::skip_empty_shards() {
+  while (shard < ref_map->shards_length-1 && current == ref_map->shards[shard].map.end()) {
+    ++shard;
+    current = ref_map->shards[shard].map.begin();
+  }
+}
+
+}
+
+#endif /* CONCURRENT_HASH_MAP_HPP_ */
@@ -0,0 +1,98 @@
+#ifndef CONTROL_GROUP_HPP_
+#define CONTROL_GROUP_HPP_
+
+#if !defined(ICS_SCALAR_PROBING) && defined(__AVX2__)
+#include <immintrin.h>
+#elif !defined(ICS_SCALAR_PROBING) && (defined(__SSE2__) || defined(_M_X64))
+#include <emmintrin.h>
+#endif
+
+
+namespace ics {
+
+//A ControlGroup examines WIDTH consecutive control bytes of an open-addressing
+//  table at once and answers with a bit mask (bit i set iff byte i matches).
+//Control bytes are EMPTY (-128), DELETED (-2), or a 7-bit tag (0..127) for a
+//  full slot. With AVX2 a group is 32 bytes compared by one instruction; with
+//  SSE2 it is 16 bytes; otherwise (or when ICS_SCALAR_PROBING is defined) the
+//  same masks are built one byte at a time.
+class ControlGroup {
+  public:
+#if !defined(ICS_SCALAR_PROBING) && defined(__AVX2__)
+    static const int WIDTH = 32;
+    explicit ControlGroup(const signed char* pos)
+      : control(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(pos))) {}
+
+    unsigned match(signed char tag) const
+    {return unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(control,_mm256_set1_epi8(tag))));}
+
+    unsigned match_empty() const
+    {return match(EMPTY);}
+
+    unsigned match_empty_or_deleted() const
+    {return unsigned(_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_set1_epi8(-1),control)));}
+
+  private:
+    __m256i control;
+#elif !defined(ICS_SCALAR_PROBING) && (defined(__SSE2__) || defined(_M_X64))
+    static const int WIDTH = 16;
+    explicit ControlGroup(const signed char* pos)
+      : control(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) {}
+
+    unsigned match(signed char tag) const
+    {return unsigned(_mm_movemask_epi8(_mm_cmpeq_epi8(control,_mm_set1_epi8(tag))));}
+
+    unsigned match_empty() const
+    {return match(EMPTY);}
+
+    unsigned match_empty_or_deleted() const
+    {return unsigned(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(-1),control)));}
+
+  private:
+    __m128i control;
+#else
+    static const int WIDTH = 16;
+    explicit ControlGroup(const signed char* pos) : control(pos) {}
+
+    unsigned match(signed char tag) const {
+      unsigned answer = 0;
+      for (int i=0; i<WIDTH; ++i)
+        answer |= unsigned(control[i] == tag) << i;
+      return answer;
+    }
+
+    unsigned match_empty() const
+    {return match(EMPTY);}
+
+    unsigned match_empty_or_deleted() const {
+      unsigned answer = 0;
+      for (int i=0; i<WIDTH; ++i)
+        answer |= unsigned(control[i] < -1) << i;
+      return answer;
+    }
+
+  private:
+    const signed char* control;
+#endif
+
+  public:
+    static const signed char EMPTY   = -128; //Never used: ends every probe
+    static const signed char DELETED = -2;   //Erased: probes continue past it
+
+    //Index of the lowest set bit in a non-0 mask; use with mask &= mask-1
+    //  to visit every matching byte in a group
+    static int lowest_bit(unsigned mask) {
+#if defined(__GNUC__)
+      return __builtin_ctz(mask);
+#else
+      int answer = 0;
+      for (; (mask & 1) == 0; mask >>= 1)
+        ++answer;
+      return answer;
+#endif
+    }
+};
+
+}
+
+#endif /* CONTROL_GROUP_HPP_ */
@@ -0,0 +1,80 @@
+//Times HeapPriorityQueue<T,ARITY> for ARITY 2, 4, and 8, to check the choice
+//  of arity (see heap_priority_queue.hpp). Build with optimization, e.g.,
+//    g++ -std=c++11 -O2 driver_heap_arity.cpp ics46goody.cpp ics_exceptions.cpp
+//Each row starts from a heap of n random values, then times either an
+//  enqueue-heavy load (4 enqueues per dequeue, n times) or a dequeue-heavy
+//  one (dequeuing until empty); Big is a 128-byte value. Times are seconds
+//  of processor time (ics::Stopwatch).
+
+#include <string>
+#include <iostream>
+#include <cstdlib>
+#include "ics46goody.hpp"
+#include "stopwatch.hpp"
+#include "heap_priority_queue.hpp"
+
+
+class Big {
+  public:
+    int  key;
+    char pad[124];
+    bool operator != (const Big& rhs) const {return key != rhs.key;}
+};
+
+std::ostream& operator << (std::ostream& outs, const Big& b) {
+  return outs << b.key;
+}
+
+bool int_gt (const int& a, const int& b) {return a > b;}
+bool big_gt (const Big& a, const Big& b) {return a.key > b.key;}
+
+int make_int (int r) {return r;}
+Big make_big (int r) {Big b; b.key = r; return b;}
+
+
+template<class T,int ARITY>
+double time_heap (bool (*gt)(const T& a, const T& b), T (*make)(int), int n, bool enqueue_heavy) {
+  std::srand(46);  //Each arity sees the same values
+  ics::HeapPriorityQueue<T,ARITY> pq(gt);
+  pq.reserve(enqueue_heavy ? 5*n : n);
+  for (int i=0; i<n; ++i)
+    pq.enqueue(make(std::rand()));
+
+  ics::Stopwatch watch;
+  watch.start();
+  if (enqueue_heavy)
+    for (int i=0; i<n; ++i) {
+      for (int e=0; e<4; ++e)
+        pq.enqueue(make(std::rand()));
+      pq.dequeue();
+    }
+  else
+    while (!pq.empty())
+      pq.dequeue();
+  watch.stop();
+  return watch.read();
+}
+
+
+template<class T>
+void time_row (const std::string& name, bool (*gt)(const T& a, const T& b), T (*make)(int), int n, bool enqueue_heavy) {
+  std::cout << name << (enqueue_heavy ? " enqueue-heavy" : " dequeue-heavy") << "  n=" << n
+            << "  d=2: " << time_heap<T,2>(gt,make,n,enqueue_heavy)
+            << "  d=4: " << time_heap<T,4>(gt,make,n,enqueue_heavy)
+            << "  d=8: " << time_heap<T,8>(gt,make,n,enqueue_heavy) << std::endl;
+}
+
+
+int main() {
+  try {
+    int n = ics::prompt_int("Enter # of values (Big uses n/4)",1000000);
+    time_row<int>("int",int_gt,make_int,n,true);
+    time_row<int>("int",int_gt,make_int,n,false);
+    time_row<Big>("Big",big_gt,make_big,n/4,true);
+    time_row<Big>("Big",big_gt,make_big,n/4,false);
+  } catch (ics::IcsError& e) {
+    std::cout << e.what() << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,59 @@
+//Times ArrayMap::has_key with int keys, which ics::scan_entry_keys compares
+//  several entries at a time (see key_scan.hpp), against Int keys: an int in
+//  a class, so the same size and layout but compared one entry at a time by
+//  the plain loop. Build with optimization, e.g.,
+//    g++ -std=c++11 -O2 driver_key_scan.cpp ics46goody.cpp ics_exceptions.cpp
+//Each row fills maps with the n even keys in [0,2n), then looks up every key
+//  in [0,2n) (half absent, in a scrambled order) over and over; times are seconds of processor time (ics::Stopwatch).
+
+#include <iostream>
+#include "ics46goody.hpp"
+#include "stopwatch.hpp"
+#include "array_map.hpp"
+
+
+class Int {
+  public:
+    Int (int v = 0) : value(v) {}
+    bool operator == (const Int& rhs) const {return value == rhs.value;}
+    bool operator != (const Int& rhs) const {return value != rhs.value;}
+    int value;
+};
+
+std::ostream& operator << (std::ostream& outs, const Int& i) {
+  return outs << i.value;
+}
+
+
+template<class K>
+double time_has_key (int n, int lookups) {
+  ics::ArrayMap<K,int> m;
+  for (int i=0; i<n; ++i)
+    m.put(K(2*i),i);
+
+  ics::Stopwatch watch;
+  watch.start();
+  int found = 0;
+  for (int l=0; l<lookups; l += 2*n)
+    for (int k=0; k<2*n; ++k)
+      found += m.has_key(K(7*k % (2*n)));  //Every key in [0,2n), out of order
+  watch.stop();
+  if (found != lookups/(2*n)*n)  //Uses found, so the lookups are not optimized away
+    std::cout << "wrong count: " << found << std::endl;
+  return watch.read();
+}
+
+
+int main() {
+  try {
+    int lookups = ics::prompt_int("Enter # of lookups per row",50000000);
+    for (int n : {4, 8, 16, 32, 64})
+      std::cout << "n=" << n
+                << "  Int (plain loop): " << time_has_key<Int>(n,lookups)
+                << "  int (scanned): "    << time_has_key<int>(n,lookups) << std::endl;
+  } catch (ics::IcsError& e) {
+    std::cout << e.what() << std::endl;
+  }
+
+  return 0;
+}
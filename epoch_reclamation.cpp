@@ -0,0 +1,115 @@
+#include "epoch_reclamation.hpp"
+
+namespace ics {
+
+//Releases the slot of the thread (if it has one) when the thread exits
+class SlotOwner {
+  public:
+    std::atomic<unsigned long>* epoch  = nullptr;
+    std::atomic<bool>*          in_use = nullptr;
+    ~SlotOwner() {
+      if (in_use != nullptr) {
+        epoch->store(~0UL,std::memory_order_release);
+        in_use->store(false,std::memory_order_release);
+      }
+    }
+};
+
+static thread_local void*     this_slot = nullptr;  //An EpochDomain::Slot*
+static thread_local SlotOwner this_slot_owner;
+
+
+EpochDomain& EpochDomain::global() {
+  static EpochDomain domain;
+  return domain;
+}
+
+
+EpochDomain::~EpochDomain() {
+  while (retired != nullptr) {
+    Retired* to_delete = retired;
+    retired = retired->next;
+    to_delete->destroy(to_delete->object);
+    delete to_delete;
+  }
+}
+
+
+//The epoch is advanced after tagging (readers entering later see the new
+//  pointer the caller stored); the fence (paired with the one in enter)
+//  ensures a reader either is seen in its slot here, or sees that pointer
+void EpochDomain::retire(void* object, void (*destroy)(void*)) {
+  std::lock_guard<std::mutex> guard(retired_lock);
+  retired = new Retired{epoch.fetch_add(1),object,destroy,retired};
+  ++retired_length;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  unsigned long oldest = oldest_epoch();
+  for (Retired** r = &retired; *r != nullptr; /*See body*/)
+    if ((*r)->epoch < oldest) {
+      Retired* to_delete = *r;
+      *r = to_delete->next;
+      to_delete->destroy(to_delete->object);
+      delete to_delete;
+      --retired_length;
+    }else
+      r = &(*r)->next;
+}
+
+
+int EpochDomain::retired_count() const {
+  std::lock_guard<std::mutex> guard(retired_lock);
+  return retired_length;
+}
+
+
+//Reuse the slot of an exited thread, or push a new one on the list
+auto EpochDomain::claim_slot() -> Slot* {
+  for (Slot* s = slots.load(std::memory_order_acquire); s != nullptr; s = s->next) {
+    bool free = false;
+    if (!s->in_use.load(std::memory_order_relaxed) && s->in_use.compare_exchange_strong(free,true))
+      return s;
+  }
+
+  Slot* s = new Slot;
+  Slot* head = slots.load(std::memory_order_relaxed);
+  do
+    s->next = head;
+  while (!slots.compare_exchange_weak(head,s,std::memory_order_release,std::memory_order_relaxed));
+  return s;
+}
+
+
+unsigned long EpochDomain::oldest_epoch() const {
+  unsigned long answer = QUIESCENT;
+  for (Slot* s = slots.load(std::memory_order_acquire); s != nullptr; s = s->next) {
+    unsigned long e = s->epoch.load(std::memory_order_seq_cst);
+    if (e < answer)
+      answer = e;
+  }
+  return answer;
+}
+
+
+void EpochDomain::enter() {
+  Slot* s = static_cast<Slot*>(this_slot);
+  if (s == nullptr) {
+    s = claim_slot();
+    this_slot = s;
+    this_slot_owner.epoch  = &s->epoch;
+    this_slot_owner.in_use = &s->in_use;
+  }
+  if (s->depth++ == 0) {
+    s->epoch.store(epoch.load(std::memory_order_acquire),std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+}
+
+
+void EpochDomain::exit() {
+  Slot* s = static_cast<Slot*>(this_slot);
+  if (--s->depth == 0)
+    s->epoch.store(QUIESCENT,std::memory_order_release);
+}
+
+}
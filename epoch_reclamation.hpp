@@ -0,0 +1,90 @@
+#ifndef EPOCH_RECLAMATION_HPP_
+#define EPOCH_RECLAMATION_HPP_
+
+#include <atomic>
+#include <mutex>
+#include "concurrency.hpp"
+
+
+namespace ics {
+
+//Epoch-based reclamation: deleting an object that other threads may still
+//  be reading, without those readers taking a lock or doing an atomic
+//  read-modify-write (used by SnapshotHashMap/SnapshotHashSet).
+//
+//A reader holds an EpochGuard while it uses the objects it loads from
+//  shared (atomic) pointers:
+//    {EpochGuard guard; const X* x = shared.load(std::memory_order_acquire); ...use *x...}
+//A writer that has replaced such an object (stored the new one's pointer
+//  in the shared pointer) calls EpochDomain::global().retire(old) instead of
+//  delete old: old is deleted once no guard that might have loaded it is
+//  still held (maybe by a later retire, or at program exit).
+//
+//There is a global epoch number; each thread has a slot (on its own cache
+//  line), which an outermost guard sets to the epoch when it is entered and
+//  clears when it is exited. retire tags the object with the epoch, then
+//  advances the epoch: a guard entered after that sees the new pointer, so
+//  an object can be deleted when every slot is clear or has a later epoch.
+//  Entering/exiting a guard costs two stores to the thread's own slot and a
+//  fence (which orders the slot's store before the reader's loads).
+class EpochDomain {
+  public:
+    static EpochDomain& global ();
+    EpochDomain(const EpochDomain& to_copy) = delete;
+    EpochDomain& operator = (const EpochDomain& rhs) = delete;
+    ~EpochDomain();  //Deletes all retired objects (no thread is reading then)
+
+    template<class X>
+    void retire (X* object) {retire(object, [] (void* o) {delete static_cast<X*>(o);});}
+    void retire (void* object, void (*destroy)(void*));
+
+    int retired_count () const;   //# retired but not yet deleted
+
+  private:
+    friend class EpochGuard;
+    static const unsigned long QUIESCENT = ~0UL;  //A slot not in any guard
+
+    class Slot {
+      public:
+        std::atomic<unsigned long> epoch {QUIESCENT};
+        std::atomic<bool>          in_use{true};    //Slots of exited threads are reused
+        int                        depth = 0;       //Of nested guards: only its thread uses it
+        Slot*                      next  = nullptr;
+        char                       pad[CACHE_LINE_SIZE];
+    };
+
+    class Retired {
+      public:
+        unsigned long epoch;
+        void*         object;
+        void        (*destroy)(void*);
+        Retired*      next;
+    };
+
+    std::atomic<unsigned long> epoch{1};
+    std::atomic<Slot*>         slots{nullptr};  //All slots ever made (never deleted)
+    mutable std::mutex         retired_lock;
+    Retired*                   retired = nullptr;
+    int                        retired_length = 0;
+
+    EpochDomain() {}
+    Slot*         claim_slot   ();              //For a new thread
+    unsigned long oldest_epoch () const;        //Of any slot in a guard
+    void          enter        ();
+    void          exit         ();
+};
+
+
+//Holds the calling thread in the (global) EpochDomain for its lifetime;
+//  guards may be nested
+class EpochGuard {
+  public:
+    EpochGuard()  {EpochDomain::global().enter();}
+    EpochGuard(const EpochGuard& to_copy) = delete;
+    EpochGuard& operator = (const EpochGuard& rhs) = delete;
+    ~EpochGuard() {EpochDomain::global().exit();}
+};
+
+}
+
+#endif /* EPOCH_RECLAMATION_HPP_ */
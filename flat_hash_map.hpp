@@ -0,0 +1,744 @@
+#ifndef FLAT_HASH_MAP_HPP_
+#define FLAT_HASH_MAP_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <functional>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "pair.hpp"
+#include "map.hpp"
+#include "control_group.hpp"
+
+
+namespace ics {
+
+//FlatHashMap is a drop-in alternative to HashMap: same constructors and Map
+//  interface, but all entries live in one contiguous array of slots (open
+//  addressing) instead of in separately allocated LNs.
+//Each slot has a one-byte control value: EMPTY, DELETED (a tombstone left by
+//  erase in a group with no EMPTY slot), or a 7-bit tag taken from the key's
+//  hash. Slots are probed a ControlGroup at a time: the tags of a whole group
+//  are compared with one vector instruction (where available), so full KEY
+//  == comparisons are made only for slots whose tags match, and a miss
+//  usually ends at the first group.
+//HASH and EQUALS are the same policies as in HashMap
+template<class KEY,class T,class HASH = std::hash<KEY>,class EQUALS = std::equal_to<KEY>> class FlatHashMap : public Map<KEY,T>	{
+  public:
+    typedef ics::pair<KEY,T> Entry;
+    explicit FlatHashMap(const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 0.875);
+    FlatHashMap(int initial_bins, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 0.875);
+    FlatHashMap(const FlatHashMap<KEY,T,HASH,EQUALS>& to_copy);
+    FlatHashMap(FlatHashMap<KEY,T,HASH,EQUALS>&& to_move);
+    FlatHashMap(std::initializer_list<Entry> il, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 0.875);
+    FlatHashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 0.875);
+    virtual ~FlatHashMap();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual bool has_key    (const KEY& key) const;
+    virtual bool has_value  (const T& value) const;
+    virtual std::string str () const;
+
+    virtual T    put   (const KEY& key, const T& value);
+    template<class... Args>
+    T&           emplace (const KEY& key, Args&&... args); //put(key,T(args...)), moving the new value in
+    virtual T    erase (const KEY& key);
+    virtual void clear ();
+
+    virtual int put   (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,Entry> put   (const ITERATOR& start, const ITERATOR& stop);
+
+    //reserve: enough slots for n keys without rehashing; shrink_to_fit: the
+    //  fewest slots allowed by the load factor. Both rehash (only if the # of
+    //  slots changes, or to clear out tombstones)
+    void reserve       (int n);
+    void shrink_to_fit ();
+
+    virtual T&       operator [] (const KEY&);
+    virtual const T& operator [] (const KEY&) const;
+    virtual FlatHashMap<KEY,T,HASH,EQUALS>& operator = (const FlatHashMap<KEY,T,HASH,EQUALS>& rhs);
+    virtual FlatHashMap<KEY,T,HASH,EQUALS>& operator = (FlatHashMap<KEY,T,HASH,EQUALS>&& rhs);
+    virtual bool operator == (const Map<KEY,T>& rhs) const;
+    virtual bool operator != (const Map<KEY,T>& rhs) const;
+
+    template<class KEY2,class T2,class HASH2,class EQUALS2>
+    friend std::ostream& operator << (std::ostream& outs, const FlatHashMap<KEY2,T2,HASH2,EQUALS2>& m);
+
+    virtual ics::Iterator<Entry>& ibegin () const;
+    virtual ics::Iterator<Entry>& iend   () const;
+
+    class Iterator final : public ics::Iterator<Entry> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(FlatHashMap<KEY,T,HASH,EQUALS>* iterate_over, bool begin);
+        Iterator(const Iterator& i);
+        virtual ~Iterator();
+        virtual Entry       erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<Entry>& operator ++ ();
+        virtual const ics::Iterator<Entry>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<Entry>& rhs) const;
+        virtual bool operator != (const ics::Iterator<Entry>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual Entry& operator *  () const;
+        virtual Entry* operator -> () const;
+      private:
+        int                 current;  //Slot index; stop: current == ref_map->bins
+        FlatHashMap<KEY,T,HASH,EQUALS>* ref_map;
+        int                 expected_mod_count;
+        bool                can_erase = true;
+        void advance_cursor();
+    };
+
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    static const signed char EMPTY   = ControlGroup::EMPTY;
+    static const signed char DELETED = ControlGroup::DELETED;
+                                     //Full slots store a tag in 0..127
+    Entry*       map     = nullptr;
+    signed char* control = nullptr;  //control[i] describes map[i]
+    HASH   hash;
+    EQUALS equals;
+    double load_factor;              //(used+deleted)/bins <= load_factor
+    int bins      = ControlGroup::WIDTH; //# slots: a power of 2, >= WIDTH
+    int used      = 0;               //# of key->value pairs in the hash table
+    int deleted   = 0;               //# of DELETED slots (tombstones)
+    int mod_count = 0;               //For sensing concurrent modification
+    std::uint64_t full_hash (const KEY& key) const;
+    int   find_key          (const KEY& key, std::uint64_t h) const;
+    int   find_slot         (std::uint64_t h) const;
+    int   insert_new        (const KEY& key, T value, std::uint64_t h);
+    void  erase_at          (int i);
+    bool  is_full           (int i) const;
+    static signed char tag_of(std::uint64_t h);
+    void  ensure_load_factor(int new_used);
+    void  rehash            (int new_bins);
+    void  allocate          (int new_bins);
+    static int round_up_bins(int n);
+    int   bins_for          (int n) const;
+    void  swap_contents     (FlatHashMap<KEY,T,HASH,EQUALS>& other);
+  };
+
+
+
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::FlatHashMap(const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  if (load_factor <= 0.0 || load_factor > 0.875)
+    load_factor = 0.875;
+  allocate(bins);
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::FlatHashMap(int initial_bins, const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor), bins(round_up_bins(initial_bins)) {
+  if (load_factor <= 0.0 || load_factor > 0.875)
+    load_factor = 0.875;
+  allocate(bins);
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::FlatHashMap(const FlatHashMap<KEY,T,HASH,EQUALS>& to_copy)
+    : hash(to_copy.hash), equals(to_copy.equals), load_factor(to_copy.load_factor), bins(to_copy.bins), used(to_copy.used), deleted(to_copy.deleted) {
+  allocate(bins);
+  for (int i=0; i<bins; ++i) {
+    control[i] = to_copy.control[i];
+    if (is_full(i))
+      map[i] = to_copy.map[i];
+  }
+}
+
+//to_move is left with an empty table (made by the delegated constructor)
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::FlatHashMap(FlatHashMap<KEY,T,HASH,EQUALS>&& to_move)
+    : FlatHashMap(to_move.hash,to_move.equals,to_move.load_factor) {
+  swap_contents(to_move);
+  ++to_move.mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::FlatHashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  if (load_factor <= 0.0 || load_factor > 0.875)
+    load_factor = 0.875;
+  allocate(bins);
+  put(start,stop);
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::FlatHashMap(std::initializer_list<Entry> il,const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  if (load_factor <= 0.0 || load_factor > 0.875)
+    load_factor = 0.875;
+  allocate(bins);
+  for (Entry m_entry : il)
+    put(m_entry.first,m_entry.second);
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::~FlatHashMap() {
+  delete[] map;
+  delete[] control;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+inline bool FlatHashMap<KEY,T,HASH,EQUALS>::empty() const {
+  return used == 0;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::size() const {
+  return used;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::has_key (const KEY& key) const {
+  return find_key(key,full_hash(key)) != -1;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::has_value (const T& value) const {
+  for (int i=0; i<bins; ++i)
+    if (is_full(i) && value == map[i].second)
+      return true;
+
+  return false;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::string FlatHashMap<KEY,T,HASH,EQUALS>::str() const {
+  std::ostringstream answer;
+  answer << std::endl;
+  for (int i=0; i<bins; ++i) {
+    answer << "slot[" << i << "] = ";
+    if (is_full(i))
+      answer << map[i] << "(tag=" << int(control[i]) << ")";
+    else
+      answer << (control[i] == EMPTY ? "EMPTY" : "DELETED");
+    answer << std::endl;
+  }
+  answer  << "(load_factor=" << load_factor << ",bins=" << bins << ",used=" << used << ",deleted=" << deleted << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+T FlatHashMap<KEY,T,HASH,EQUALS>::put(const KEY& key, const T& value) {
+  std::uint64_t h = full_hash(key);
+  int i = find_key(key,h);
+  T to_return;
+  if (i != -1) {
+    to_return = map[i].second;
+    map[i].second = value;
+  }else{
+    to_return = value;
+    insert_new(key,value,h);
+  }
+  ++mod_count;
+  return to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class... Args>
+T& FlatHashMap<KEY,T,HASH,EQUALS>::emplace(const KEY& key, Args&&... args) {
+  std::uint64_t h = full_hash(key);
+  int i = find_key(key,h);
+  if (i != -1)
+    map[i].second = T(std::forward<Args>(args)...);
+  else
+    i = insert_new(key,T(std::forward<Args>(args)...),h);
+  ++mod_count;
+  return map[i].second;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+T FlatHashMap<KEY,T,HASH,EQUALS>::erase(const KEY& key) {
+  int i = find_key(key,full_hash(key));
+  if (i == -1) {
+    std::ostringstream answer;
+    answer << "FlatHashMap::erase: key(" << key << ") not in Map";
+    throw KeyError(answer.str());
+  }
+  T to_return = map[i].second;
+  erase_at(i);
+  ++mod_count;
+  return to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::clear() {
+  for (int i=0; i<bins; ++i) {
+    if (is_full(i))
+      map[i] = Entry();
+    control[i] = EMPTY;
+  }
+
+  used    = 0;
+  deleted = 0;
+  ++mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop) {
+  int count = 0;
+  for (; start != stop; ++start) {
+    ++count;
+    put(start->first,start->second);
+  }
+
+  return count;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class ITERATOR>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::put (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,Entry> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i) {
+    ++count;
+    put(i->first,i->second);
+  }
+
+  return count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+T& FlatHashMap<KEY,T,HASH,EQUALS>::operator [] (const KEY& key) {
+  std::uint64_t h = full_hash(key);
+  int i = find_key(key,h);
+  if (i != -1)
+    return map[i].second;
+
+  i = insert_new(key,T(),h);  //map may have changed
+  ++mod_count;
+  return map[i].second;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+const T& FlatHashMap<KEY,T,HASH,EQUALS>::operator [] (const KEY& key) const {
+  int i = find_key(key,full_hash(key));
+  if (i != -1)
+    return map[i].second;
+
+  std::ostringstream answer;
+  answer << "FlatHashMap::operator []: key(" << key << ") not in Map";
+  throw KeyError(answer.str());
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::operator == (const Map<KEY,T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+
+  for (int i=0; i<bins; ++i)
+    // Uses ! and ==, so != on T need not be defined
+    if (is_full(i) && (!rhs.has_key(map[i].first) || !(map[i].second == rhs[map[i].first])))
+      return false;
+
+  return true;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>& FlatHashMap<KEY,T,HASH,EQUALS>::operator = (const FlatHashMap<KEY,T,HASH,EQUALS>& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  delete[] map;
+  delete[] control;
+  hash        = rhs.hash;
+  equals      = rhs.equals;
+  load_factor = rhs.load_factor;
+  bins        = rhs.bins;
+  used        = rhs.used;
+  deleted     = rhs.deleted;
+  allocate(bins);
+  for (int i=0; i<bins; ++i) {
+    control[i] = rhs.control[i];
+    if (is_full(i))
+      map[i] = rhs.map[i];
+  }
+
+  ++mod_count;
+  return *this;
+}
+
+//rhs gets (and later deletes) this map's old arrays
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>& FlatHashMap<KEY,T,HASH,EQUALS>::operator = (FlatHashMap<KEY,T,HASH,EQUALS>&& rhs) {
+  swap_contents(rhs);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::operator != (const Map<KEY,T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::ostream& operator << (std::ostream& outs, const FlatHashMap<KEY,T,HASH,EQUALS>& m) {
+  outs << "map[";
+
+  if (!m.empty()) {
+    bool first = true;
+    for (int i=0; i<m.bins; ++i)
+      if (m.is_full(i)) {
+        outs << (first ? "" : ",") << m.map[i].first << "->" << m.map[i].second;
+        first = false;
+      }
+  }
+
+  outs << "]";
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class HASH,class EQUALS>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::ibegin () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<FlatHashMap<KEY,T,HASH,EQUALS>*>(this),true));
+}
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class HASH,class EQUALS>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::iend () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<FlatHashMap<KEY,T,HASH,EQUALS>*>(this),false));
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::begin () const -> FlatHashMap<KEY,T,HASH,EQUALS>::Iterator {
+  return Iterator(const_cast<FlatHashMap<KEY,T,HASH,EQUALS>*>(this),true);
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::end () const -> FlatHashMap<KEY,T,HASH,EQUALS>::Iterator {
+  return Iterator(const_cast<FlatHashMap<KEY,T,HASH,EQUALS>*>(this),false);
+}
+
+
+//Scramble the user's hash (which is often the identity on ints) so both the
+//  tag (low 7 bits) and the starting slot (higher bits) are well distributed
+template<class KEY,class T,class HASH,class EQUALS>
+inline std::uint64_t FlatHashMap<KEY,T,HASH,EQUALS>::full_hash (const KEY& key) const {
+  std::uint64_t h = std::uint64_t(hash(key)) * 0x9E3779B97F4A7C15ULL;
+  return h ^ (h >> 29);
+}
+
+//Probe whole groups (aligned at multiples of WIDTH), visiting every group
+//  via triangular steps; a group holding any EMPTY slot ends the probe
+//Return the slot storing key, or -1 if key is not in the table
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::find_key (const KEY& key, std::uint64_t h) const {
+  signed char tag   = tag_of(h);
+  int         gmask = bins/ControlGroup::WIDTH-1;
+  for (int g = int(h >> 7) & gmask, step = 1; /*See body*/; g = (g+step++) & gmask) {
+    int base = g*ControlGroup::WIDTH;
+    ControlGroup group(control+base);
+    for (unsigned m = group.match(tag); m != 0; m &= m-1) {
+      int i = base + ControlGroup::lowest_bit(m);
+      if (equals(key,map[i].first))
+        return i;
+    }
+    if (group.match_empty() != 0)
+      return -1;
+  }
+}
+
+//Return the first EMPTY or DELETED slot on the probe sequence for h
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::find_slot (std::uint64_t h) const {
+  int gmask = bins/ControlGroup::WIDTH-1;
+  for (int g = int(h >> 7) & gmask, step = 1; /*See body*/; g = (g+step++) & gmask) {
+    int base = g*ControlGroup::WIDTH;
+    unsigned m = ControlGroup(control+base).match_empty_or_deleted();
+    if (m != 0)
+      return base + ControlGroup::lowest_bit(m);
+  }
+}
+
+//key must not already be in the table; returns the slot it was stored in
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::insert_new (const KEY& key, T value, std::uint64_t h) {
+  ensure_load_factor(used+1);
+  int i = find_slot(h);
+  if (control[i] == DELETED)
+    --deleted;
+  control[i] = tag_of(h);
+  map[i] = Entry(key,std::move(value));
+  ++used;
+  return i;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+inline signed char FlatHashMap<KEY,T,HASH,EQUALS>::tag_of (std::uint64_t h) {
+  return static_cast<signed char>(h & 0x7F);
+}
+
+//A group that still has an EMPTY slot has never been probed past, so the
+//  erased slot can become EMPTY instead of a tombstone
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::erase_at (int i) {
+  map[i] = Entry();  //Release any resources the entry holds
+  int base = i - i%ControlGroup::WIDTH;
+  if (ControlGroup(control+base).match_empty() != 0)
+    control[i] = EMPTY;
+  else{
+    control[i] = DELETED;
+    ++deleted;
+  }
+  --used;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+inline bool FlatHashMap<KEY,T,HASH,EQUALS>::is_full (int i) const {
+  return control[i] >= 0;
+}
+
+//Tombstones count against the load factor (they lengthen probes), so a table
+//  with many of them is rehashed at the same size to clear them out
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::ensure_load_factor(int new_used) {
+  if (double(new_used+deleted)/double(bins) <= load_factor)
+    return;
+
+  if (double(new_used)/double(bins) <= load_factor/2)
+    rehash(bins);
+  else
+    rehash(2*bins);
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::rehash(int new_bins) {
+  Entry*       old_map     = map;
+  signed char* old_control = control;
+  int          old_bins    = bins;
+
+  bins    = new_bins;
+  deleted = 0;
+  allocate(bins);
+
+  for (int i=0; i<old_bins; ++i)
+    if (old_control[i] >= 0) {
+      std::uint64_t h = full_hash(old_map[i].first);
+      int s = find_slot(h);
+      control[s] = tag_of(h);
+      map[s] = std::move(old_map[i]);
+    }
+
+  delete[] old_map;
+  delete[] old_control;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::allocate(int new_bins) {
+  map     = new Entry[new_bins];
+  control = new signed char[new_bins];
+  for (int i=0; i<new_bins; ++i)
+    control[i] = EMPTY;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::round_up_bins(int n) {
+  int answer = ControlGroup::WIDTH;
+  while (answer < n)
+    answer *= 2;
+  return answer;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+int FlatHashMap<KEY,T,HASH,EQUALS>::bins_for(int n) const {
+  return round_up_bins(int(std::ceil(double(n)/load_factor)));
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::reserve(int n) {
+  int new_bins = bins_for(n);
+  if (new_bins > bins) {
+    rehash(new_bins);
+    ++mod_count;
+  }
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::shrink_to_fit() {
+  int new_bins = bins_for(used);
+  if (new_bins < bins || deleted != 0) {
+    rehash(new_bins < bins ? new_bins : bins);
+    ++mod_count;
+  }
+}
+
+//Exchange everything but mod_count (each map keeps counting its own changes)
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::swap_contents (FlatHashMap<KEY,T,HASH,EQUALS>& other) {
+  std::swap(map,         other.map);
+  std::swap(control,     other.control);
+  std::swap(hash,        other.hash);
+  std::swap(equals,      other.equals);
+  std::swap(load_factor, other.load_factor);
+  std::swap(bins,        other.bins);
+  std::swap(used,        other.used);
+  std::swap(deleted,     other.deleted);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+void FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::advance_cursor(){
+  for (++current; current<ref_map->bins && !ref_map->is_full(current); ++current)
+    ;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::Iterator(FlatHashMap<KEY,T,HASH,EQUALS>* iterate_over, bool begin) : ref_map(iterate_over) {
+  current = ref_map->bins;
+  if (begin) {
+    current = -1;
+    advance_cursor();
+  }
+  expected_mod_count = ref_map->mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::Iterator(const Iterator& i) :
+    current(i.current), ref_map(i.ref_map), expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {}
+
+template<class KEY,class T,class HASH,class EQUALS>
+FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::~Iterator()
+{}
+
+template<class KEY,class T,class HASH,class EQUALS>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::erase() -> Entry {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("FlatHashMap::Iterator::erase Iterator cursor already erased");
+  if (current < 0 || current >= ref_map->bins)
+    throw CannotEraseError("FlatHashMap::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  Entry to_return = ref_map->map[current];
+  ref_map->erase_at(current);
+  ++ref_map->mod_count;
+  expected_mod_count = ref_map->mod_count;
+
+  return to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::string FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_map->str() << "(current=" << current << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+//Erasing marks the current slot EMPTY if its group still has an EMPTY slot,
+//  and DELETED (a tombstone) otherwise; either way nothing shifts into it,
+//  so ++ always moves on to the next full slot
+//KLUDGE: cannot use Entry
+template<class KEY,class T,class HASH,class EQUALS>
+auto  FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator ++ () -> const ics::Iterator<ics::pair<KEY,T>>& {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::operator ++");
+
+  if (current >= ref_map->bins)
+    return *this;
+
+  advance_cursor();
+  can_erase = true;
+  return *this;
+}
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class KEY,class T,class HASH,class EQUALS>
+auto FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator ++ (int) -> const ics::Iterator<ics::pair<KEY,T>>&{
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::operator ++(int)");
+
+  Iterator* to_return = new Iterator(*this);
+  if (current >= ref_map->bins)
+    return *to_return;
+
+  advance_cursor();
+  can_erase = true;
+  return *to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator == (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("FlatHashMap::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::operator ==");
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("FlatHashMap::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator != (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("FlatHashMap::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::operator !=");
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("FlatHashMap::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+ics::pair<KEY,T>& FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator *() const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::operator *");
+  if (!can_erase || current < 0 || current >= ref_map->bins)
+    throw IteratorPositionIllegal("FlatHashMap::Iterator::operator * Iterator illegal: exhausted");
+
+  return ref_map->map[current];
+}
+
+template<class KEY,class T,class HASH,class EQUALS>
+ics::pair<KEY,T>* FlatHashMap<KEY,T,HASH,EQUALS>::Iterator::operator ->() const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("FlatHashMap::Iterator::operator ->");
+  if (!can_erase || current < 0 || current >= ref_map->bins)
+    throw IteratorPositionIllegal("FlatHashMap::Iterator::operator -> Iterator illegal: exhausted");
+
+  return &(ref_map->map[current]);
+}
+
+}
+
+#endif /* FLAT_HASH_MAP_HPP_ */
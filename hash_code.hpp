@@ -0,0 +1,37 @@
+#ifndef HASH_CODE_HPP_
+#define HASH_CODE_HPP_
+
+#include <cstddef>
+
+
+namespace ics {
+
+//The nodes of a hash table derive from HashCode<CACHE>. When CACHE is true
+//  each node remembers the hash code of its key, so lookups compare codes
+//  before (expensive) keys and resizing never calls the hash function again;
+//  when CACHE is false a node stores nothing extra, may_equal is always true,
+//  and recall recomputes the code.
+template<bool CACHE>
+class HashCode {
+  public:
+    HashCode(std::size_t code = 0) : hash_code(code) {}
+    bool may_equal (std::size_t code) const {return hash_code == code;}
+    template<class HASH,class KEY>
+    std::size_t recall (const HASH& /*hash*/, const KEY& /*key*/) const {return hash_code;}
+  private:
+    std::size_t hash_code;
+};
+
+
+template<>
+class HashCode<false> {
+  public:
+    HashCode(std::size_t /*code*/ = 0) {}
+    bool may_equal (std::size_t /*code*/) const {return true;}
+    template<class HASH,class KEY>
+    std::size_t recall (const HASH& hash, const KEY& key) const {return hash(key);}
+};
+
+}
+
+#endif /* HASH_CODE_HPP_ */
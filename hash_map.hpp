@@ -1,592 +1,875 @@
-#ifndef HASH_MAP_HPP_
-#define HASH_MAP_HPP_
-
-#include <string>
-#include <iostream>
-#include <sstream>
-#include <initializer_list>
-#include "ics_exceptions.hpp"
-#include "iterator.hpp"
-#include "pair.hpp"
-#include "map.hpp"
-#include "array_queue.hpp"   //For traversal
-
-
-namespace ics {
-
-template<class KEY,class T> class HashMap : public Map<KEY,T>	{
-  public:
-    typedef ics::pair<KEY,T> Entry;
-    HashMap() = delete;
-    HashMap(int (*ahash)(const KEY& k), double the_load_factor = 1.0);
-    HashMap(int initial_bins, int (*ahash)(const KEY& k), double the_load_factor = 1.0);
-	  HashMap(const HashMap<KEY,T>& to_copy);
-	  HashMap(std::initializer_list<Entry> il, int (*ahash)(const KEY& k), double the_load_factor = 1.0);
-    HashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, int (*ahash)(const KEY& k), double the_load_factor = 1.0);
-	  virtual ~HashMap();
-
-    virtual bool empty      () const;
-    virtual int  size       () const;
-    virtual bool has_key    (const KEY& key) const;
-    virtual bool has_value  (const T& value) const;
-    virtual std::string str () const;
-
-    virtual T    put   (const KEY& key, const T& value);
-    virtual T    erase (const KEY& key);
-    virtual void clear ();
-
-    virtual int put   (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop);
-
-    virtual T&       operator [] (const KEY&);
-    virtual const T& operator [] (const KEY&) const;
-    virtual HashMap<KEY,T>& operator = (const HashMap<KEY,T>& rhs);
-    virtual bool operator == (const Map<KEY,T>& rhs) const;
-    virtual bool operator != (const Map<KEY,T>& rhs) const;
-
-    template<class KEY2,class T2>
-    friend std::ostream& operator << (std::ostream& outs, const HashMap<KEY2,T2>& m);
-
-    virtual ics::Iterator<Entry>& ibegin () const;
-    virtual ics::Iterator<Entry>& iend   () const;
-
-   private:
-     class LN;
-
-   public:
-     class Iterator : public ics::Iterator<Entry> {
-       public:
-        //KLUDGE should be callable only in begin/end
-        Iterator(HashMap<KEY,T>* iterate_over, bool begin);
-        Iterator(const Iterator& i);
-        virtual ~Iterator();
-        virtual Entry       erase();
-        virtual std::string str  () const;
-        virtual const ics::Iterator<Entry>& operator ++ ();
-        virtual const ics::Iterator<Entry>& operator ++ (int);
-        virtual bool operator == (const ics::Iterator<Entry>& rhs) const;
-        virtual bool operator != (const ics::Iterator<Entry>& rhs) const;
-        virtual Entry& operator *  () const;
-        virtual Entry* operator -> () const;
-      private:
-        ics::pair<int,LN*> current; //Bin Index and Cursor; stop: LN* == nullptr
-        HashMap<KEY,T>*    ref_map;
-        int                expected_mod_count;
-        bool               can_erase = true;
-        void advance_cursors();
-    };
-
-    virtual Iterator begin () const;
-    virtual Iterator end   () const;
-    //KLUDGE: define
-    //virtual ics::Iterator<KEY>&  begin_key   () const;
-    //virtual ics::Iterator<KEY>&  end_key     () const;
-    //virtual ics::Iterator<T>&    begin_value () const;
-    //virtual ics::Iterator<T>&    end_value   () const;
-
-    private:
-      class LN {
-        public:
-          LN ()                         : next(nullptr){}
-          LN (const LN& ln)             : value(ln.value), next(ln.next){}
-          LN (Entry v, LN* n = nullptr) : value(v), next(n){}
-
-          Entry value;
-          LN*   next;
-      };
-
-      LN** map      = nullptr;
-      int (*hash)(const KEY& k);
-      double load_factor;//used/bins <= load_factor
-      int bins      = 1; //# bins in array
-      int used      = 0; //# of key->value pairs in the hash table
-      int mod_count = 0; //For sensing concurrent modification
-      int   hash_compress (const KEY& key) const;
-      void  ensure_load_factor(int new_used);
-      LN*   find_key (int bin, const KEY& key) const;
-      bool  find_value (const T& value) const;
-      LN*   copy_list(LN*   l) const;
-      LN**  copy_hash_table(LN** ht, int bins) const;
-      void  delete_hash_table(LN**& ht, int bins);
-  };
-
-
-
-
-
-template<class KEY,class T>
-HashMap<KEY,T>::HashMap(int (*ahash)(const KEY& k), double the_load_factor)
-    : hash(ahash), load_factor(the_load_factor) {
-  map = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    map[b] = new LN();
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::HashMap(int initial_bins, int (*ahash)(const KEY& k), double the_load_factor)
-    : bins(initial_bins), hash(ahash), load_factor(the_load_factor) {
-  map = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    map[b] = new LN();
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::HashMap(const HashMap<KEY,T>& to_copy)
-    : hash(to_copy.hash), load_factor(to_copy.load_factor), bins(to_copy.bins), used(to_copy.used) {
-  map  = copy_hash_table(to_copy.map,bins);
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::HashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, int (*ahash)(const KEY& k), double the_load_factor)
-    : hash(ahash), load_factor(the_load_factor) {
-  map = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    map[b] = new LN();
-  put(start,stop);
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::HashMap(std::initializer_list<Entry> il,int (*ahash)(const KEY& k), double the_load_factor)
-    : hash(ahash), load_factor(the_load_factor) {
-  map = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    map[b] = new LN();
-  for (Entry m_entry : il)
-    put(m_entry.first,m_entry.second);
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::~HashMap() {
-  delete_hash_table(map,bins);
-}
-
-
-template<class KEY,class T>
-inline bool HashMap<KEY,T>::empty() const {
-  return used == 0;
-}
-
-template<class KEY,class T>
-int HashMap<KEY,T>::size() const {
-  return used;
-}
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::has_key (const KEY& key) const {
-  return find_key(hash_compress(key),key) != nullptr;
-}
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::has_value (const T& value) const {
-  return find_value(value);
-}
-
-template<class KEY,class T>
-std::string HashMap<KEY,T>::str() const {
-  std::ostringstream answer;
-  if (bins == 0)
-    answer << "empty";
-  else
-    answer << std::endl;
-    for (int b=0; b<bins; ++b) {
-      answer << "bin[" << b << "] = ";
-      for (LN* c = map[b]; c->next!=nullptr; c=c->next)
-        answer << c->value << " -> " ;
-      answer << "#" << std::endl;
-    }
-  answer  << "(load_factor=" << load_factor << ",bins=" << bins << ",used=" <<used <<",mod_count=" << mod_count << ")";
-  return answer.str();
-}
-
-template<class KEY,class T>
-T HashMap<KEY,T>::put(const KEY& key, const T& value) {
-  int bin = hash_compress(key);
-  T to_return;
-  LN* c = find_key(bin,key);
-  if (c != nullptr) {
-    to_return = c->value.second;
-    c->value.second = value;
-  }else{
-    to_return = value;
-    ensure_load_factor(used+1);
-    ++used;
-    bin = hash_compress(key);  //bins may have changed
-    map[bin] = new LN(ics::make_pair(key,value),map[bin]);
-  }
-  ++mod_count;
-  return to_return;
-}
-
-template<class KEY,class T>
-T HashMap<KEY,T>::erase(const KEY& key) {
-  LN* c = find_key(hash_compress(key),key);
-  if (c == nullptr) {
-    std::ostringstream answer;
-    answer << "HashMap::erase: key(" << key << ") not in Map";
-    throw KeyError(answer.str());
-  }
-  T to_return = c->value.second;
-  LN* to_delete = c->next;
-  *c = *(c->next);
-  delete to_delete;
-  --used;
-  ++mod_count;
-  return to_return;
-}
-
-template<class KEY,class T>
-void HashMap<KEY,T>::clear() {
-  for (int b=0; b<bins; ++b) {
-    LN* c=map[b];
-    for (; c->next!=nullptr; /*See body*/) {
-      LN* to_delete = c;
-      c = c->next;
-      delete to_delete;
-    }
-    map[b] = c;
-  }
-
-  used = 0;
-  ++mod_count;
-}
-
-template<class KEY,class T>
-int HashMap<KEY,T>::put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop) {
-  int count = 0;
-  for (; start != stop; ++start) {
-    ++count;
-    put(start->first,start->second);
-  }
-
-  return count;
-}
-
-template<class KEY,class T>
-T& HashMap<KEY,T>::operator [] (const KEY& key) {
-  int bin = hash_compress(key);
-  LN* c = find_key(bin,key);
-  if (c != nullptr) {
-    return c->value.second;
-  }
-
-  ensure_load_factor(used+1);
-  ++used;
-  ++mod_count;
-  bin = hash_compress(key);  //bins may have changed
-  map[bin] = new LN(ics::make_pair(key,T()),map[bin]);
-  return map[bin]->value.second;
-}
-
-template<class KEY,class T>
-const T& HashMap<KEY,T>::operator [] (const KEY& key) const {
-  int bin = hash_compress(key);
-  LN* c = find_key(bin,key);
-  if (c != nullptr)
-    return c->value.second;
-
-  std::ostringstream answer;
-  answer << "HashMap::operator []: key(" << key << ") not in Map";
-  throw KeyError(answer.str());
-}
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::operator == (const Map<KEY,T>& rhs) const {
-  if (this == &rhs)
-    return true;
-  if (used != rhs.size())
-    return false;
-
-  for (int b=0; b<bins; ++b)
-    for (LN* c=map[b]; c->next!=nullptr; c=c->next)
-       if (rhs.has_key(c->value.first) && c->value.second !=  rhs[c->value.first])
-         return false;
-
-  return true;
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>& HashMap<KEY,T>::operator = (const HashMap<KEY,T>& rhs) {
-  if (this == &rhs)
-    return *this;
-
-  delete_hash_table(map,bins);
-  map         = copy_hash_table(rhs.map,rhs.bins);
-  hash        = rhs.hash;
-  load_factor = rhs.load_factor;
-  bins        = rhs.bins;
-  used        = rhs.used;
-
-  ++mod_count;
-  return *this;
-}
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::operator != (const Map<KEY,T>& rhs) const {
-  return !(*this == rhs);
-}
-
-
-template<class KEY,class T>
-std::ostream& operator << (std::ostream& outs, const HashMap<KEY,T>& m) {
-  if (m.empty()) {
-    outs << "map[]";
-  }else{
-    outs << "map[";
-    ics::Iterator<ics::pair<KEY,T>>& i = m.ibegin();
-    outs << i->first << "->" << i->second;
-    ++i;
-    for (/*See above*/; i != m.iend(); ++i)
-      outs << "," << i->first << "->" << i->second;
-    outs << "]";
-  }
-  return outs;
-}
-
-//KLUDGE: memory-leak
-template<class KEY,class T>
-auto HashMap<KEY,T>::ibegin () const -> ics::Iterator<Entry>& {
-  return *(new Iterator(const_cast<HashMap<KEY,T>*>(this),true));
-}
-
-//KLUDGE: memory-leak
-template<class KEY,class T>
-auto HashMap<KEY,T>::iend () const -> ics::Iterator<Entry>& {
-  return *(new Iterator(const_cast<HashMap<KEY,T>*>(this),false));
-}
-
-template<class KEY,class T>
-auto HashMap<KEY,T>::begin () const -> HashMap<KEY,T>::Iterator {
-  return Iterator(const_cast<HashMap<KEY,T>*>(this),true);
-}
-
-template<class KEY,class T>
-auto HashMap<KEY,T>::end () const -> HashMap<KEY,T>::Iterator {
-  return Iterator(const_cast<HashMap<KEY,T>*>(this),false);
-}
-
-template<class KEY,class T>
-int HashMap<KEY,T>::hash_compress (const KEY& key) const {
-  return abs(hash(key)) % bins;
-}
-
-template<class KEY,class T>
-void HashMap<KEY,T>::ensure_load_factor(int new_used) {
-  if (double(new_used)/double(bins) <= load_factor)
-    return;
-
-  LN** old_map  = map;
-  int  old_bins = bins;
-
-  bins = 2*old_bins;
-  map = new LN*[bins];
-
-  for (int b=0; b<bins; ++b)
-    map[b] = new LN();
-
-  for (int b=0; b<old_bins; ++b) {
-    LN* c=old_map[b];
-    for (; c->next!=nullptr; /*See body*/) {
-      int bin = hash_compress(c->value.first);
-      LN* to_move = c;
-      c = c->next;
-      to_move->next = map[bin];
-      map[bin] = to_move;
-    }
-    delete c;
-  }
-  delete [] old_map;
-}
-
-template<class KEY,class T>
-typename HashMap<KEY,T>::LN* HashMap<KEY,T>::find_key (int bin, const KEY& key) const {
-  for (LN* c = map[bin]; c->next!=nullptr; c=c->next)
-    if (key == c->value.first)
-      return c;
-
-  return nullptr;
-}
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::find_value (const T& value) const {
-  for (int b=0; b<bins; ++b)
-    for (LN* c = map[b]; c->next!=nullptr; c=c->next)
-      if (value == c->value.second)
-        return true;
-
-  return false;
-}
-
-template<class KEY,class T>
-typename HashMap<KEY,T>::LN* HashMap<KEY,T>::copy_list (LN* l) const {
-  if (l == nullptr)
-    return nullptr;
-  else
-    return new LN(l->value, copy_list(l->next));
-}
-
-template<class KEY,class T>
-typename HashMap<KEY,T>::LN** HashMap<KEY,T>::copy_hash_table (LN** ht, int bins) const {
-  LN** answer = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-     answer[b] = copy_list(ht[b]);
-  return answer;
-}
-
-template<class KEY,class T>
-void HashMap<KEY,T>::delete_hash_table (LN**& ht, int bins) {
-  for (int b=0; b<bins; ++b)
-    for (LN* c=ht[b]; c!=nullptr; /*See body*/) {
-      LN* to_delete = c;
-      c = c->next;
-      delete to_delete;
-  }
-  delete[] ht;
-  ht = nullptr;
-}
-
-
-template<class KEY,class T>
-void HashMap<KEY,T>::Iterator::advance_cursors(){
-  if (current.second != nullptr && current.second->next != nullptr && current.second->next->next != nullptr) {
-    current.second = current.second->next;
-    return;
-  }else
-    for (int b=current.first+1; b<ref_map->bins; ++b)
-      if (ref_map->map[b]->next != nullptr) {
-        current.first  = b;
-        current.second = ref_map->map[b];
-        return;
-      }
-  current.first  = -1;
-  current.second = nullptr;
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::Iterator::Iterator(HashMap<KEY,T>* iterate_over, bool begin) : ref_map(iterate_over) {
-  current = ics::pair<int,LN*>(-1,nullptr);
-  if (begin)
-     advance_cursors();
-  expected_mod_count = ref_map->mod_count;
-}
-
-template<class KEY,class T>
-HashMap<KEY,T>::Iterator::Iterator(const Iterator& i) :
-    current(i.current), ref_map(i.ref_map), expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {}
-
-template<class KEY,class T>
-HashMap<KEY,T>::Iterator::~Iterator()
-{}
-
-template<class KEY,class T>
-auto HashMap<KEY,T>::Iterator::erase() -> Entry {
-  if (expected_mod_count != ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::erase");
-  if (!can_erase)
-    throw CannotEraseError("HashMap::Iterator::erase Iterator cursor already erased");
-  if (current.second == nullptr)
-    throw CannotEraseError("HashMap::Iterator::erase Iterator cursor beyond data structure");
-
-  can_erase = false;
-  Entry to_return = current.second->value;
-  LN* to_delete = current.second->next;
-
-  *current.second = *(current.second->next);
-  --ref_map->used;
-  ++ref_map->mod_count;
-  expected_mod_count = ref_map->mod_count;
-  delete to_delete;
-
-  return to_return;
-}
-
-template<class KEY,class T>
-std::string HashMap<KEY,T>::Iterator::str() const {
-  std::ostringstream answer;
-  answer << ref_map->str() << "(current=" << current.first << "/" << current.second << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
-  return answer.str();
-}
-
-//KLUDGE: cannot use Entry
-template<class KEY,class T>
-auto  HashMap<KEY,T>::Iterator::operator ++ () -> const ics::Iterator<ics::pair<KEY,T>>& {
-  if (expected_mod_count != ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::operator ++");
-
-  if (current.second == nullptr)
-    return *this;
-
-  if (can_erase || current.second->next == nullptr)
-    advance_cursors();
-
-  can_erase = true;
-  return *this;
-}
-
-//KLUDGE: creates garbage! (can return local value!)
-template<class KEY,class T>
-auto HashMap<KEY,T>::Iterator::operator ++ (int) -> const ics::Iterator<ics::pair<KEY,T>>&{
-  if (expected_mod_count != ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::operator ++(int)");
-
-  Iterator* to_return = new Iterator(*this);
-  if (current.second == nullptr)
-    return *to_return;
-
-  if (can_erase || current.second->next == nullptr)
-    advance_cursors();
-
-  can_erase = true;
-  return *to_return;
-}
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::Iterator::operator == (const ics::Iterator<Entry>& rhs) const {
-  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
-  if (rhsASI == 0)
-    throw IteratorTypeError("HashMap::Iterator::operator ==");
-  if (expected_mod_count != ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::operator ==");
-  if (ref_map != rhsASI->ref_map)
-    throw ComparingDifferentIteratorsError("HashMap::Iterator::operator ==");
-
-  return this->current.second == rhsASI->current.second;
-}
-
-
-template<class KEY,class T>
-bool HashMap<KEY,T>::Iterator::operator != (const ics::Iterator<Entry>& rhs) const {
-  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
-  if (rhsASI == 0)
-    throw IteratorTypeError("HashMap::Iterator::operator !=");
-  if (expected_mod_count != ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::operator !=");
-  if (ref_map != rhsASI->ref_map)
-    throw ComparingDifferentIteratorsError("HashMap::Iterator::operator !=");
-
-  return this->current.second != rhsASI->current.second;
-}
-
-template<class KEY,class T>
-ics::pair<KEY,T>& HashMap<KEY,T>::Iterator::operator *() const {
-  if (expected_mod_count !=
-      ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::operator *");
-  if (!can_erase || current.second == nullptr)
-    throw IteratorPositionIllegal("HashMap::Iterator::operator * Iterator illegal: exhausted");
-
-  return current.second->value;
-}
-
-template<class KEY,class T>
-ics::pair<KEY,T>* HashMap<KEY,T>::Iterator::operator ->() const {
-  if (expected_mod_count !=
-      ref_map->mod_count)
-    throw ConcurrentModificationError("HashMap::Iterator::operator *");
-  if (!can_erase || current.second == nullptr)
-    throw IteratorPositionIllegal("HashMap::Iterator::operator -> Iterator illegal: exhausted");
-
-  return &(current.second->value);
-}
-
-}
-
-#endif /* HASH_MAP_HPP_ */
+#ifndef HASH_MAP_HPP_
+#define HASH_MAP_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <type_traits>
+#include <functional>
+#include <cstddef>
+#include <cmath>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "node_pool.hpp"
+#include "hash_code.hpp"
+#include "bin_policy.hpp"
+#include "pair.hpp"
+#include "map.hpp"
+#include "array_queue.hpp"   //For traversal
+
+
+namespace ics {
+
+//HASH and EQUALS are function objects (or function pointer types) called as
+//  hash(key) -> std::size_t and equals(key1,key2) -> bool; by default
+//  std::hash<KEY> and std::equal_to<KEY> (i.e., KEY's ==)
+//  The constructors take the objects to call (ahash/aequals), which must be
+//  supplied for function pointers or function objects with state
+//NODE_POOL allocates all LNs: ics::NodePool (the default) carves them from
+//  slabs and recycles erased ones; ics::NewDeletePool uses plain new/delete
+//CACHE_HASH stores each key's hash code in its LN (see HashCode): by default
+//  only for non-scalar keys (e.g., std::string), whose hashing/== is costly
+//BIN_POLICY sizes the bins and compresses hash codes into them (see
+//  bin_policy.hpp): ics::ModuloBins (the default) allows any # of bins and
+//  uses %; ics::MaskBins and ics::FibonacciBins keep bins a power of 2 so no
+//  division is needed
+template<class KEY,class T,class HASH = std::hash<KEY>,class EQUALS = std::equal_to<KEY>,
+         template<class> class NODE_POOL = ics::NodePool,bool CACHE_HASH = !std::is_scalar<KEY>::value,
+         class BIN_POLICY = ics::ModuloBins>
+class HashMap : public Map<KEY,T>	{
+  public:
+    typedef ics::pair<KEY,T> Entry;
+    explicit HashMap(const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+    HashMap(int initial_bins, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+	  HashMap(const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& to_copy);
+	  HashMap(HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& to_move);
+	  HashMap(std::initializer_list<Entry> il, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+    HashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+	  virtual ~HashMap();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual bool has_key    (const KEY& key) const;
+    virtual bool has_value  (const T& value) const;
+    virtual std::string str () const;
+
+    virtual T    put   (const KEY& key, const T& value);
+    template<class... Args>
+    T&           emplace (const KEY& key, Args&&... args); //put(key,T(args...)), moving the new value in
+    virtual T    erase (const KEY& key);
+    virtual void clear ();
+
+    virtual int put   (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,Entry> put   (const ITERATOR& start, const ITERATOR& stop);
+
+    //bins_per_operation == 0 (the default): double the table all at once when
+    //  the load factor is exceeded; > 0: keep the old bins alongside the doubled
+    //  ones, and move this many old bins into the new ones on each put/erase/[]
+    //  (const operations, copying, and iterating never move any)
+    void incremental_rehash (int bins_per_operation);
+
+    //reserve: enough bins (and pooled LNs) for n keys without rehashing;
+    //  shrink_to_fit: the fewest bins allowed by the load factor, and a new
+    //  pool holding only the live LNs
+    void reserve       (int n);
+    void shrink_to_fit ();
+
+    virtual T&       operator [] (const KEY&);
+    virtual const T& operator [] (const KEY&) const;
+    virtual HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& operator = (const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& rhs);
+    virtual HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& operator = (HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& rhs);
+    virtual bool operator == (const Map<KEY,T>& rhs) const;
+    virtual bool operator != (const Map<KEY,T>& rhs) const;
+
+    template<class KEY2,class T2,class HASH2,class EQUALS2,template<class> class NODE_POOL2,bool CACHE_HASH2,class BIN_POLICY2>
+    friend std::ostream& operator << (std::ostream& outs, const HashMap<KEY2,T2,HASH2,EQUALS2,NODE_POOL2,CACHE_HASH2,BIN_POLICY2>& m);
+
+    virtual ics::Iterator<Entry>& ibegin () const;
+    virtual ics::Iterator<Entry>& iend   () const;
+
+   private:
+     class LN;
+
+   public:
+     class Iterator final : public ics::Iterator<Entry> {
+       public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>* iterate_over, bool begin);
+        Iterator(const Iterator& i);
+        Iterator& operator = (const Iterator& i) = default;  //e.g., by ConcurrentHashMap::Iterator
+        virtual ~Iterator();
+        virtual Entry       erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<Entry>& operator ++ ();
+        virtual const ics::Iterator<Entry>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<Entry>& rhs) const;
+        virtual bool operator != (const ics::Iterator<Entry>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual Entry& operator *  () const;
+        virtual Entry* operator -> () const;
+      private:
+        ics::pair<int,LN*> current; //Bin Index and Cursor; stop: LN* == nullptr
+        HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*    ref_map;
+        int                expected_mod_count;
+        bool               can_erase = true;
+        void advance_cursors();
+    };
+
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+    //KLUDGE: define
+    //virtual ics::Iterator<KEY>&  begin_key   () const;
+    //virtual ics::Iterator<KEY>&  end_key     () const;
+    //virtual ics::Iterator<T>&    begin_value () const;
+    //virtual ics::Iterator<T>&    end_value   () const;
+
+    private:
+      class LN : public HashCode<CACHE_HASH> {
+        public:
+          LN ()                                               : next(nullptr){}
+          LN (const LN& ln)                                   : HashCode<CACHE_HASH>(ln), value(ln.value), next(ln.next){}
+          LN (const LN& ln, LN* n)                            : HashCode<CACHE_HASH>(ln), value(ln.value), next(n){}
+          LN (Entry v, LN* n = nullptr, std::size_t code = 0) : HashCode<CACHE_HASH>(code), value(std::move(v)), next(n){}
+          LN& operator = (const LN& ln) = default;
+          LN& operator = (LN&& ln)      = default;
+
+          Entry value;
+          LN*   next;
+      };
+
+      NODE_POOL<LN> pool;           //Allocates every LN (sentinels too)
+      LN** map      = nullptr;
+      HASH   hash;
+      EQUALS equals;
+      double load_factor;//used/bins <= load_factor
+      int bins      = 1; //# bins in array
+      int used      = 0; //# of key->value pairs in the hash table (both arrays)
+      int mod_count = 0; //For sensing concurrent modification
+      LN** old_map     = nullptr; //Non-nullptr only while incrementally rehashing
+      int  old_bins    = 0;       //# bins in old_map
+      int  migrated    = 0;       //old_map[0..migrated-1] are already moved/empty
+      int  rehash_step = 0;       //# old bins to move per operation; 0: all at once
+      int   hash_compress (std::size_t hash_code, int in_bins) const;
+      int   bins_for (int n) const;
+      void  ensure_load_factor(int new_used);
+      void  start_rehash (int new_bins);
+      void  migrate_bins (int count);
+      void  finish_rehash();
+      LN*   find_key (int bin, const KEY& key, std::size_t hash_code) const;
+      LN*   find_key (const KEY& key, std::size_t hash_code) const;
+      bool  find_value (const T& value) const;
+      LN*   copy_list(LN*   l);
+      LN**  copy_hash_table(LN** ht, int bins);
+      void  copy_tables (const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& other);
+      void  delete_hash_table(LN**& ht, int bins);
+      void  swap_contents (HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& other);
+  };
+
+
+
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashMap(const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  map = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+    map[b] = pool.make();
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashMap(int initial_bins, const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : bins(BIN_POLICY::round_bins(initial_bins)), hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  map = new LN*[bins];
+  pool.reserve(bins);
+  for (int b=0; b<bins; ++b)
+    map[b] = pool.make();
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashMap(const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& to_copy)
+    : hash(to_copy.hash), equals(to_copy.equals), load_factor(to_copy.load_factor), rehash_step(to_copy.rehash_step) {
+  copy_tables(to_copy);
+}
+
+//to_move is left with an empty 1-bin table (made by the delegated constructor)
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashMap(HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& to_move)
+    : HashMap(to_move.hash,to_move.equals,to_move.load_factor) {
+  swap_contents(to_move);
+  ++to_move.mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  map = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+    map[b] = pool.make();
+  put(start,stop);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashMap(std::initializer_list<Entry> il,const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  map = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+    map[b] = pool.make();
+  for (Entry m_entry : il)
+    put(m_entry.first,m_entry.second);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::~HashMap() {
+  delete_hash_table(map,bins);
+  if (old_map != nullptr)
+    delete_hash_table(old_map,old_bins);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+inline bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::empty() const {
+  return used == 0;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::size() const {
+  return used;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::has_key (const KEY& key) const {
+  return find_key(key,hash(key)) != nullptr;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::has_value (const T& value) const {
+  return find_value(value);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+std::string HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::str() const {
+  std::ostringstream answer;
+  if (bins == 0)
+    answer << "empty";
+  else
+    answer << std::endl;
+    for (int b=0; b<bins; ++b) {
+      answer << "bin[" << b << "] = ";
+      for (LN* c = map[b]; c->next!=nullptr; c=c->next)
+        answer << c->value << " -> " ;
+      answer << "#" << std::endl;
+    }
+  for (int b=migrated; old_map != nullptr && b<old_bins; ++b) {
+    answer << "old_bin[" << b << "] = ";
+    for (LN* c = old_map[b]; c->next!=nullptr; c=c->next)
+      answer << c->value << " -> " ;
+    answer << "#" << std::endl;
+  }
+  answer  << "(load_factor=" << load_factor << ",bins=" << bins << ",used=" <<used <<",mod_count=" << mod_count;
+  if (old_map != nullptr)
+    answer << ",old_bins=" << old_bins << ",migrated=" << migrated;
+  answer << ")";
+  return answer.str();
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+T HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::put(const KEY& key, const T& value) {
+  if (old_map != nullptr)
+    migrate_bins(rehash_step);
+  std::size_t code = hash(key);
+  T to_return;
+  LN* c = find_key(key,code);
+  if (c != nullptr) {
+    to_return = c->value.second;
+    c->value.second = value;
+  }else{
+    to_return = value;
+    ensure_load_factor(used+1);
+    ++used;
+    int bin = hash_compress(code,bins);  //bins may have changed
+    map[bin] = pool.make(ics::make_pair(key,value),map[bin],code);
+  }
+  ++mod_count;
+  return to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+template<class... Args>
+T& HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::emplace(const KEY& key, Args&&... args) {
+  if (old_map != nullptr)
+    migrate_bins(rehash_step);
+  std::size_t code = hash(key);
+  LN* c = find_key(key,code);
+  ++mod_count;
+  if (c != nullptr) {
+    c->value.second = T(std::forward<Args>(args)...);
+    return c->value.second;
+  }
+
+  ensure_load_factor(used+1);
+  ++used;
+  int bin = hash_compress(code,bins);  //bins may have changed
+  map[bin] = pool.make(Entry(key,T(std::forward<Args>(args)...)),map[bin],code);
+  return map[bin]->value.second;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+T HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::erase(const KEY& key) {
+  if (old_map != nullptr)
+    migrate_bins(rehash_step);
+  LN* c = find_key(key,hash(key));
+  if (c == nullptr) {
+    std::ostringstream answer;
+    answer << "HashMap::erase: key(" << key << ") not in Map";
+    throw KeyError(answer.str());
+  }
+  T to_return = std::move(c->value.second);
+  LN* to_delete = c->next;
+  *c = std::move(*(c->next));
+  pool.release(to_delete);
+  --used;
+  ++mod_count;
+  return to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::clear() {
+  finish_rehash();
+  for (int b=0; b<bins; ++b) {
+    LN* c=map[b];
+    for (; c->next!=nullptr; /*See body*/) {
+      LN* to_delete = c;
+      c = c->next;
+      pool.release(to_delete);
+    }
+    map[b] = c;
+  }
+
+  used = 0;
+  ++mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop) {
+  int count = 0;
+  for (; start != stop; ++start) {
+    ++count;
+    put(start->first,start->second);
+  }
+
+  return count;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+template<class ITERATOR>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::put (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,Entry> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i) {
+    ++count;
+    put(i->first,i->second);
+  }
+
+  return count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+T& HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator [] (const KEY& key) {
+  if (old_map != nullptr)
+    migrate_bins(rehash_step);
+  std::size_t code = hash(key);
+  LN* c = find_key(key,code);
+  if (c != nullptr) {
+    return c->value.second;
+  }
+
+  ensure_load_factor(used+1);
+  ++used;
+  ++mod_count;
+  int bin = hash_compress(code,bins);  //bins may have changed
+  map[bin] = pool.make(ics::make_pair(key,T()),map[bin],code);
+  return map[bin]->value.second;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+const T& HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator [] (const KEY& key) const {
+  LN* c = find_key(key,hash(key));
+  if (c != nullptr)
+    return c->value.second;
+
+  std::ostringstream answer;
+  answer << "HashMap::operator []: key(" << key << ") not in Map";
+  throw KeyError(answer.str());
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator == (const Map<KEY,T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+
+  for (int b=0; b<bins; ++b)
+    for (LN* c=map[b]; c->next!=nullptr; c=c->next)
+       if (!rhs.has_key(c->value.first) || c->value.second !=  rhs[c->value.first])
+         return false;
+  for (int b=migrated; old_map != nullptr && b<old_bins; ++b)
+    for (LN* c=old_map[b]; c->next!=nullptr; c=c->next)
+       if (!rhs.has_key(c->value.first) || c->value.second !=  rhs[c->value.first])
+         return false;
+
+  return true;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator = (const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  delete_hash_table(map,bins);
+  if (old_map != nullptr)
+    delete_hash_table(old_map,old_bins);
+  hash        = rhs.hash;
+  equals      = rhs.equals;
+  load_factor = rhs.load_factor;
+  rehash_step = rhs.rehash_step;
+  copy_tables(rhs);
+
+  ++mod_count;
+  return *this;
+}
+
+//rhs gets (and later deletes) this map's old table and LNs
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator = (HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& rhs) {
+  swap_contents(rhs);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator != (const Map<KEY,T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+std::ostream& operator << (std::ostream& outs, const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& m) {
+  if (m.empty()) {
+    outs << "map[]";
+  }else{
+    outs << "map[";
+    bool first = true;
+    for (const ics::pair<KEY,T>& kv : m) {
+      outs << (first ? "" : ",") << kv.first << "->" << kv.second;
+      first = false;
+    }
+    outs << "]";
+  }
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::ibegin () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),true));
+}
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::iend () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),false));
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::begin () const -> HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator {
+  return Iterator(const_cast<HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),true);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::end () const -> HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator {
+  return Iterator(const_cast<HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),false);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+inline int HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::hash_compress (std::size_t hash_code, int in_bins) const {
+  return BIN_POLICY::compress(hash_code,in_bins);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::ensure_load_factor(int new_used) {
+  if (double(new_used)/double(bins) <= load_factor)
+    return;
+  start_rehash(2*bins);
+}
+
+//Move all LNs into a new table with new_bins bins: at once, or (if
+//  rehash_step > 0) a few old bins at a time, starting now
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::start_rehash(int new_bins) {
+  finish_rehash();  //At most one old_map at a time
+  old_map  = map;
+  old_bins = bins;
+  migrated = 0;
+
+  bins = new_bins;
+  map = new LN*[bins];
+
+  pool.reserve(bins);  //All new sentinels come from one slab
+  for (int b=0; b<bins; ++b)
+    map[b] = pool.make();
+
+  if (rehash_step == 0)
+    finish_rehash();
+}
+
+//Move the LNs in the next count bins of old_map into map; when all are
+//  moved, delete old_map (the whole table is then just map/bins). Moving
+//  LNs changes the order iterators visit them in, so it counts as a change
+//  (even in an operation, like finding a present key, that changes nothing)
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::migrate_bins(int count) {
+  if (count > 0 && migrated < old_bins)
+    ++mod_count;
+  for (/*See body*/; count > 0 && migrated < old_bins; --count, ++migrated) {
+    LN* c=old_map[migrated];
+    for (; c->next!=nullptr; /*See body*/) {
+      int bin = hash_compress(c->recall(hash,c->value.first),bins);
+      LN* to_move = c;
+      c = c->next;
+      to_move->next = map[bin];
+      map[bin] = to_move;
+    }
+    old_map[migrated] = c;  //Just the sentinel
+  }
+
+  if (migrated == old_bins) {
+    delete_hash_table(old_map,old_bins);
+    old_bins = 0;
+    migrated = 0;
+  }
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::finish_rehash() {
+  if (old_map != nullptr)
+    migrate_bins(old_bins);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::incremental_rehash(int bins_per_operation) {
+  rehash_step = bins_per_operation < 0 ? 0 : bins_per_operation;
+  if (rehash_step == 0)
+    finish_rehash();
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::bins_for(int n) const {
+  return BIN_POLICY::round_bins(int(std::ceil(double(n)/load_factor)));
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::reserve(int n) {
+  int new_bins = bins_for(n);
+  if (new_bins > bins) {
+    start_rehash(new_bins);
+    finish_rehash();
+    ++mod_count;
+  }
+  pool.reserve(n-used);
+}
+
+//Remake every LN (including the sentinels) in a new pool, so all the slabs
+//  holding erased LNs are returned to the heap
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::shrink_to_fit() {
+  finish_rehash();
+  int new_bins = bins_for(used);
+
+  NODE_POOL<LN> new_pool;
+  new_pool.reserve(new_bins+used);
+  LN** new_map = new LN*[new_bins];
+  for (int b=0; b<new_bins; ++b)
+    new_map[b] = new_pool.make();
+
+  for (int b=0; b<bins; ++b)
+    for (LN* c = map[b]; c != nullptr; /*See body*/) {
+      if (c->next != nullptr) {
+        int bin = hash_compress(c->recall(hash,c->value.first),new_bins);
+        new_map[bin] = new_pool.make(*c,new_map[bin]);
+      }
+      LN* to_release = c;
+      c = c->next;
+      pool.release(to_release);
+    }
+  delete [] map;
+
+  map  = new_map;
+  bins = new_bins;
+  pool.swap(new_pool);
+  ++mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN* HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::find_key (int bin, const KEY& key, std::size_t hash_code) const {
+  for (LN* c = map[bin]; c->next!=nullptr; c=c->next)
+    if (c->may_equal(hash_code) && equals(key,c->value.first))
+      return c;
+
+  return nullptr;
+}
+
+//While rehashing incrementally, a key whose old bin has not yet migrated is
+//  in old_map; new keys always go into map
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN* HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::find_key (const KEY& key, std::size_t hash_code) const {
+  if (old_map != nullptr) {
+    int old_bin = hash_compress(hash_code,old_bins);
+    if (old_bin >= migrated)
+      for (LN* c = old_map[old_bin]; c->next!=nullptr; c=c->next)
+        if (c->may_equal(hash_code) && equals(key,c->value.first))
+          return c;
+  }
+  return find_key(hash_compress(hash_code,bins),key,hash_code);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::find_value (const T& value) const {
+  for (int b=0; b<bins; ++b)
+    for (LN* c = map[b]; c->next!=nullptr; c=c->next)
+      if (value == c->value.second)
+        return true;
+  for (int b=migrated; old_map != nullptr && b<old_bins; ++b)
+    for (LN* c = old_map[b]; c->next!=nullptr; c=c->next)
+      if (value == c->value.second)
+        return true;
+
+  return false;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN* HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::copy_list (LN* l) {
+  if (l == nullptr)
+    return nullptr;
+  else
+    return pool.make(*l, copy_list(l->next));
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN** HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::copy_hash_table (LN** ht, int bins) {
+  LN** answer = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+     answer[b] = copy_list(ht[b]);
+  return answer;
+}
+
+//Copy other's table(s) as they are: if other is rehashing incrementally, so
+//  is this map (from the same point), and other is not changed
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::copy_tables (const HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& other) {
+  bins     = other.bins;
+  used     = other.used;
+  map      = copy_hash_table(other.map,bins);
+  old_bins = other.old_bins;
+  migrated = other.migrated;
+  old_map  = other.old_map == nullptr ? nullptr : copy_hash_table(other.old_map,old_bins);
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::delete_hash_table (LN**& ht, int bins) {
+  for (int b=0; b<bins; ++b)
+    for (LN* c=ht[b]; c!=nullptr; /*See body*/) {
+      LN* to_delete = c;
+      c = c->next;
+      pool.release(to_delete);
+  }
+  delete[] ht;
+  ht = nullptr;
+}
+
+//Exchange everything but mod_count (each map keeps counting its own changes)
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::swap_contents (HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& other) {
+  pool.swap(other.pool);
+  std::swap(map,         other.map);
+  std::swap(hash,        other.hash);
+  std::swap(equals,      other.equals);
+  std::swap(load_factor, other.load_factor);
+  std::swap(bins,        other.bins);
+  std::swap(used,        other.used);
+  std::swap(old_map,     other.old_map);
+  std::swap(old_bins,    other.old_bins);
+  std::swap(migrated,    other.migrated);
+  std::swap(rehash_step, other.rehash_step);
+}
+
+
+//Bin index b < bins is map[b]; while rehashing incrementally, bins+b is
+//  old_map[b] (migrated old bins hold just their sentinels, so are skipped)
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::advance_cursors(){
+  if (current.second != nullptr && current.second->next != nullptr && current.second->next->next != nullptr) {
+    current.second = current.second->next;
+    return;
+  }else
+    for (int b=current.first+1; b<ref_map->bins+ref_map->old_bins; ++b) {
+      LN* bin = b < ref_map->bins ? ref_map->map[b] : ref_map->old_map[b-ref_map->bins];
+      if (bin->next != nullptr) {
+        current.first  = b;
+        current.second = bin;
+        return;
+      }
+    }
+  current.first  = -1;
+  current.second = nullptr;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::Iterator(HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>* iterate_over, bool begin) : ref_map(iterate_over) {
+  current = ics::pair<int,LN*>(-1,nullptr);
+  if (begin)
+     advance_cursors();
+  expected_mod_count = ref_map->mod_count;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::Iterator(const Iterator& i) :
+    current(i.current), ref_map(i.ref_map), expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::~Iterator()
+{}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::erase() -> Entry {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("HashMap::Iterator::erase Iterator cursor already erased");
+  if (current.second == nullptr)
+    throw CannotEraseError("HashMap::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  Entry to_return = current.second->value;
+  LN* to_delete = current.second->next;
+
+  *current.second = *(current.second->next);
+  --ref_map->used;
+  ++ref_map->mod_count;
+  expected_mod_count = ref_map->mod_count;
+  ref_map->pool.release(to_delete);
+
+  return to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+std::string HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_map->str() << "(current=" << current.first << "/" << current.second << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+//KLUDGE: cannot use Entry
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto  HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator ++ () -> const ics::Iterator<ics::pair<KEY,T>>& {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::operator ++");
+
+  if (current.second == nullptr)
+    return *this;
+
+  if (can_erase || current.second->next == nullptr)
+    advance_cursors();
+
+  can_erase = true;
+  return *this;
+}
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator ++ (int) -> const ics::Iterator<ics::pair<KEY,T>>&{
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::operator ++(int)");
+
+  Iterator* to_return = new Iterator(*this);
+  if (current.second == nullptr)
+    return *to_return;
+
+  if (can_erase || current.second->next == nullptr)
+    advance_cursors();
+
+  can_erase = true;
+  return *to_return;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator == (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("HashMap::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::operator ==");
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("HashMap::Iterator::operator ==");
+
+  return this->current.second == rhs.current.second;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator != (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("HashMap::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::operator !=");
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("HashMap::Iterator::operator !=");
+
+  return this->current.second != rhs.current.second;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+ics::pair<KEY,T>& HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator *() const {
+  if (expected_mod_count !=
+      ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::operator *");
+  if (!can_erase || current.second == nullptr)
+    throw IteratorPositionIllegal("HashMap::Iterator::operator * Iterator illegal: exhausted");
+
+  return current.second->value;
+}
+
+template<class KEY,class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+ics::pair<KEY,T>* HashMap<KEY,T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator ->() const {
+  if (expected_mod_count !=
+      ref_map->mod_count)
+    throw ConcurrentModificationError("HashMap::Iterator::operator *");
+  if (!can_erase || current.second == nullptr)
+    throw IteratorPositionIllegal("HashMap::Iterator::operator -> Iterator illegal: exhausted");
+
+  return &(current.second->value);
+}
+
+}
+
+#endif /* HASH_MAP_HPP_ */
@@ -1,614 +1,781 @@
-#ifndef HASH_SET_HPP_
-#define HASH_SET_HPP_
-
-#include <string>
-#include <iostream>
-#include <sstream>
-#include <initializer_list>
-#include "ics_exceptions.hpp"
-#include "pair.hpp"
-#include "iterator.hpp"
-#include "set.hpp"
-
-
-namespace ics {
-
-template<class T> class HashSet : public Set<T>	{
-  public:
-    HashSet() = delete;
-    HashSet(int (*ahash)(const T& element), double the_load_factor = 1.0);
-    HashSet(int initial_bins, int (*ahash)(const T& element), double the_load_factor = 1.0);
-    HashSet(const HashSet<T>& to_copy);
-    HashSet(std::initializer_list<T> il, int (*ahash)(const T& element), double the_load_factor = 1.0);
-    HashSet(ics::Iterator<T>& start, const ics::Iterator<T>& stop, int (*ahash)(const T& element), double the_load_factor = 1.0);
-    virtual ~HashSet();
-
-    virtual bool empty      () const;
-    virtual int  size       () const;
-    virtual bool contains   (const T& element) const;
-    virtual std::string str () const;
-
-    virtual bool contains (ics::Iterator<T>& start, const ics::Iterator<T>& stop) const;
-
-    virtual int  insert (const T& element);
-    virtual int  erase  (const T& element);
-    virtual void clear  ();
-
-    virtual int insert (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
-    virtual int erase  (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
-    virtual int retain (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
-
-    virtual HashSet<T>& operator = (const HashSet<T>& rhs);
-    virtual bool operator == (const Set<T>& rhs) const;
-    virtual bool operator != (const Set<T>& rhs) const;
-    virtual bool operator <= (const Set<T>& rhs) const;
-    virtual bool operator <  (const Set<T>& rhs) const;
-    virtual bool operator >= (const Set<T>& rhs) const;
-    virtual bool operator >  (const Set<T>& rhs) const;
-
-    template<class T2>
-    friend std::ostream& operator << (std::ostream& outs, const HashSet<T2>& s);
-
-    virtual ics::Iterator<T>& ibegin () const;
-    virtual ics::Iterator<T>& iend   () const;
-
-  private:
-    class LN;
-
-  public:
-    class Iterator : public ics::Iterator<T> {
-      public:
-        //KLUDGE should be callable only in begin/end
-        Iterator(HashSet<T>* iterate_over, bool begin);
-        Iterator(const Iterator& i);
-        virtual ~Iterator();
-        virtual T           erase();
-        virtual std::string str  () const;
-        virtual const ics::Iterator<T>& operator ++ ();
-        virtual const ics::Iterator<T>& operator ++ (int);
-        virtual bool operator == (const ics::Iterator<T>& rhs) const;
-        virtual bool operator != (const ics::Iterator<T>& rhs) const;
-        virtual T& operator *  () const;
-        virtual T* operator -> () const;
-      private:
-        ics::pair<int,LN*> current; //Bin Index and Cursor; stop: LN* == nullptr
-        HashSet<T>*        ref_set;
-        int                expected_mod_count;
-        bool               can_erase = true;
-        void advance_cursors();
-    };
-
-    virtual Iterator begin () const;
-    virtual Iterator end   () const;
-
-  private:
-    class LN {
-      public:
-        LN ()                      : next(nullptr){}
-        LN (const LN& ln)          : value(ln.value), next(ln.next){}
-        LN (T v,  LN* n = nullptr) : value(v), next(n){}
-
-        T   value;
-        LN* next;
-    };
-
-    LN** set      = nullptr;
-    int (*hash)(const T& element);
-    double load_factor;//used/bins <= load_factor
-    int bins      = 1; //# bins in array
-    int used      = 0; //# of key->value pairs in the hash table
-    int mod_count = 0; //For sensing concurrent modification
-    int   hash_compress (const T& element) const;
-    void  ensure_load_factor(int new_used);
-    LN*   find_element (int bin, const T& element) const;
-    LN*   copy_list(LN*   l) const;
-    LN**  copy_hash_table(LN** ht, int bins) const;
-    void  delete_hash_table(LN**& ht, int bins);
-  };
-
-
-
-
-
-template<class T>
-HashSet<T>::HashSet(int (*ahash)(const T& element), double the_load_factor)
-    : hash(ahash), load_factor(the_load_factor) {
-  set = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    set[b] = new LN();
-}
-
-template<class T>
-HashSet<T>::HashSet(int initial_bins, int (*ahash)(const T& element), double the_load_factor)
-    : bins(initial_bins), hash(ahash), load_factor(the_load_factor) {
-  set = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    set[b] = new LN();
-}
-
-template<class T>
-HashSet<T>::HashSet(const HashSet<T>& to_copy)
-    : hash(to_copy.hash), load_factor(to_copy.load_factor), bins(to_copy.bins), used(to_copy.used) {
-  set  = copy_hash_table(to_copy.set,bins);
-}
-
-template<class T>
-HashSet<T>::HashSet(ics::Iterator<T>& start, const ics::Iterator<T>& stop, int (*ahash)(const T& element), double the_load_factor)
-    : hash(ahash), load_factor(the_load_factor) {
-  set = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    set[b] = new LN();
-  insert(start,stop);
-}
-
-template<class T>
-HashSet<T>::HashSet(std::initializer_list<T> il,int (*ahash)(const T& k), double the_load_factor)
-    : hash(ahash), load_factor(the_load_factor) {
-  set = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-    set[b] = new LN();
-  for (T s_elem : il)
-    insert(s_elem);
-}
-
-template<class T>
-HashSet<T>::~HashSet() {
-  delete_hash_table(set,bins);
-}
-
-
-template<class T>
-inline bool HashSet<T>::empty() const {
-  return used == 0;
-}
-
-template<class T>
-int HashSet<T>::size() const {
-  return used;
-}
-
-template<class T>
-bool HashSet<T>::contains (const T& element) const {
-  return find_element(hash_compress(element),element) != nullptr;
-}
-
-template<class T>
-std::string HashSet<T>::str() const {
-  std::ostringstream answer;
-  if (bins == 0)
-    answer << "empty";
-  else
-    answer << std::endl;
-    for (int b=0; b<bins; ++b) {
-      answer << "bin[" << b << "] = ";
-      for (LN* c = set[b]; c->next!=nullptr; c=c->next)
-        answer << c->value << " -> " ;
-      answer << "#" << std::endl;
-    }
-  answer  << "(load_factor=" << load_factor << ",bins=" << bins << ",used=" <<used <<",mod_count=" << mod_count << ")";
-  return answer.str();
-}
-
-template<class T>
-bool HashSet<T>::contains(ics::Iterator<T>& start, const ics::Iterator<T>& stop) const {
-  for (; start != stop; ++start)
-    if (!contains(*start))
-      return false;
-
-  return true;
-}
-
-template<class T>
-int HashSet<T>::insert(const T& element) {
-  int bin = hash_compress(element);
-  LN* c = find_element(bin,element);
-  if (c != nullptr)
-      return 0;
-
-  ensure_load_factor(used+1);
-  bin = hash_compress(element);  //bins may have changed
-  set[bin] = new LN(element,set[bin]);
-  ++used;
-  ++mod_count;
-  return 1;
-}
-
-template<class T>
-int HashSet<T>::erase(const T& element) {
-  LN* c = find_element(hash_compress(element),element);
-  if (c == nullptr)
-    return 0;
-
-  LN* to_delete = c->next;
-  *c = *(c->next);
-  delete to_delete;
-  --used;
-  ++mod_count;
-  return 1;
-}
-
-template<class T>
-void HashSet<T>::clear() {
-  for (int b=0; b<bins; ++b) {
-    LN* l=set[b];
-    for (; l->next!=nullptr; /*See body*/) {
-      LN* to_delete = l;
-      l = l->next;
-      delete to_delete;
-    }
-    set[b] = l;
-  }
-
-  used = 0;
-  ++mod_count;
-}
-
-template<class T>
-int HashSet<T>::insert(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
-  int count = 0;
-  for (; start != stop; ++start)
-    count += insert(*start);
-
-  return count;
-}
-
-template<class T>
-int HashSet<T>::erase(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
-  int count = 0;
-  for (; start != stop; ++start)
-    count += erase(*start);
-  return count;
-}
-
-template<class T>
-int HashSet<T>::retain(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
-  HashSet<T> s(start,stop,hash);
-  int count = 0;
-  for (int b=0; b<bins; ++b)
-    for (LN* c=set[b]; c->next!=nullptr; /*See body*/) {
-      if (s.contains(c->value))
-        c = c-> next;
-      else{
-        LN* to_delete = c->next;
-        *c = *(c->next);
-        delete to_delete;
-        ++count;
-      }
-    }
-
-  used -= count;
-  return count;
-}
-
-template<class T>
-HashSet<T>& HashSet<T>::operator = (const HashSet<T>& rhs) {
-  if (this == &rhs)
-    return *this;
-
-  delete_hash_table(set,bins);
-  set         = copy_hash_table(rhs.set,rhs.bins);
-  hash        = rhs.hash;
-  load_factor = rhs.load_factor;
-  bins        = rhs.bins;
-  used        = rhs.used;
-
-  ++mod_count;
-  return *this;
-}
-
-template<class T>
-bool HashSet<T>::operator == (const Set<T>& rhs) const {
-  if (this == &rhs)
-    return true;
-  if (used != rhs.size())
-    return false;
-
-  for (int b=0; b<bins; ++b)
-    for (LN* c=set[b]; c->next!=nullptr; c=c->next)
-       if (!rhs.contains(c->value))
-         return false;
-
-  return true;
-}
-
-template<class T>
-bool HashSet<T>::operator != (const Set<T>& rhs) const {
-  return !(*this == rhs);
-}
-
-template<class T>
-bool HashSet<T>::operator <= (const Set<T>& rhs) const {
-  if (this == &rhs)
-    return true;
-  if (used > rhs.size())
-    return false;
-  for (int b=0; b<bins; ++b)
-    for (LN* c=set[b]; c->next!=nullptr; c=c->next)
-      if (!rhs.contains(c->value))
-        return false;
-
-  return true;
-}
-
-template<class T>
-bool HashSet<T>::operator < (const Set<T>& rhs) const {
-  if (this == &rhs)
-    return false;
-  if (used >= rhs.size())
-    return false;
-  for (int b=0; b<bins; ++b)
-    for (LN* c=set[b]; c->next!=nullptr; c=c->next)
-      if (!rhs.contains(c->value))
-        return false;
-
-  return true;
-}
-
-template<class T>
-bool HashSet<T>::operator >= (const Set<T>& rhs) const {
-  return rhs <= *this;
-}
-
-template<class T>
-bool HashSet<T>::operator > (const Set<T>& rhs) const {
-  return rhs < *this;
-}
-
-template<class T>
-std::ostream& operator << (std::ostream& outs, const HashSet<T>& s) {
-  if (s.empty()) {
-    outs << "set[]";
-  }else{
-    outs << "set[";
-    ics::Iterator<T>& i = s.ibegin();
-    outs << *i;
-    ++i;
-    for (/*See above*/; i != s.iend(); ++i)
-      outs << "," << *i;
-    outs << "]";
-  }
-  return outs;
-}
-
-//KLUDGE: memory-leak
-template<class T>
-auto HashSet<T>::ibegin () const -> ics::Iterator<T>& {
-  return *(new Iterator(const_cast<HashSet<T>*>(this),true));
-}
-
-//KLUDGE: memory-leak
-template<class T>
-auto HashSet<T>::iend () const -> ics::Iterator<T>& {
-  return *(new Iterator(const_cast<HashSet<T>*>(this),false));
-}
-
-template<class T>
-auto HashSet<T>::begin () const -> HashSet<T>::Iterator {
-  return Iterator(const_cast<HashSet<T>*>(this),true);
-}
-
-template<class T>
-auto HashSet<T>::end () const -> HashSet<T>::Iterator {
-  return Iterator(const_cast<HashSet<T>*>(this),false);
-}
-
-template<class T>
-int HashSet<T>::hash_compress (const T& element) const {
-  return abs(hash(element)) % bins;
-}
-
-template<class T>
-void HashSet<T>::ensure_load_factor(int new_used) {
-  if (double(new_used)/double(bins) <= load_factor)
-    return;
-
-  LN** old_set  = set;
-  int  old_bins = bins;
-
-  bins = 2*old_bins;
-  set = new LN*[bins];
-
-  for (int b=0; b<bins; ++b)
-    set[b] = new LN();
-
-  for (int b=0; b<old_bins; ++b) {
-    LN* c=old_set[b];
-    for (; c->next!=nullptr; /*See body*/) {
-      int bin = hash_compress(c->value);
-      LN* to_move = c;
-      c = c->next;
-      to_move->next = set[bin];
-      set[bin] = to_move;
-    }
-    delete c;
-  }
-  delete [] old_set;
-}
-
-template<class T>
-typename HashSet<T>::LN* HashSet<T>::find_element (int bin, const T& element) const {
-  for (LN* c = set[bin]; c->next!=nullptr; c=c->next)
-    if (element == c->value)
-      return c;
-
-  return nullptr;
-}
-
-template<class T>
-typename HashSet<T>::LN* HashSet<T>::copy_list (LN* l) const {
-  if (l == nullptr)
-    return nullptr;
-  else
-    return new LN(l->value, copy_list(l->next));
-}
-
-template<class T>
-typename HashSet<T>::LN** HashSet<T>::copy_hash_table (LN** ht, int bins) const {
-  LN** answer = new LN*[bins];
-  for (int b=0; b<bins; ++b)
-     answer[b] = copy_list(ht[b]);
-  return answer;
-}
-
-template<class T>
-void HashSet<T>::delete_hash_table (LN**& ht, int bins) {
-  for (int b=0; b<bins; ++b)
-    for (LN* c=ht[b]; c!=nullptr; /*See body*/) {
-      LN* to_delete = c;
-      c = c->next;
-      delete to_delete;
-  }
-  delete[] ht;
-  ht = nullptr;
-}
-
-
-template<class T>
-void HashSet<T>::Iterator::advance_cursors(){
-  if (current.second != nullptr && current.second->next != nullptr && current.second->next->next != nullptr) {
-    current.second = current.second->next;
-    return;
-  }else
-    for (int b=current.first+1; b<ref_set->bins; ++b)
-      if (ref_set->set[b]->next != nullptr) {
-        current.first  = b;
-        current.second = ref_set->set[b];
-        return;
-      }
-  current.first  = -1;
-  current.second = nullptr;
-}
-
-
-
-
-template<class T>
-HashSet<T>::Iterator::Iterator(HashSet<T>* iterate_over, bool begin) : ref_set(iterate_over) {
-  current = ics::pair<int,LN*>(-1,nullptr);
-  if (begin)
-     advance_cursors();
-  expected_mod_count = ref_set->mod_count;
-}
-
-
-template<class T>
-HashSet<T>::Iterator::Iterator(const Iterator& i) :
-    current(i.current), ref_set(i.ref_set), expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {}
-
-template<class T>
-HashSet<T>::Iterator::~Iterator()
-{}
-
-template<class T>
-T HashSet<T>::Iterator::erase() {
-  if (expected_mod_count != ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::erase");
-  if (!can_erase)
-    throw CannotEraseError("HashSet::Iterator::erase Iterator cursor already erased");
-  if (current.second == nullptr)
-    throw CannotEraseError("HashSet::Iterator::erase Iterator cursor beyond data structure");
-
-  can_erase = false;
-  T to_return = current.second->value;
-  LN* to_delete = current.second->next;
-
-  *current.second = *(current.second->next);
-  --ref_set->used;
-  ++ref_set->mod_count;
-  expected_mod_count = ref_set->mod_count;
-  delete to_delete;
-
-  return to_return;
-}
-
-template<class T>
-std::string HashSet<T>::Iterator::str() const {
-  std::ostringstream answer;
-  answer << ref_set->str() << "(current=" << current.first << "/" << current.second << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
-  return answer.str();
-}
-
-template<class T>
-const ics::Iterator<T>& HashSet<T>::Iterator::operator ++ () {
-  if (expected_mod_count != ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::operator ++");
-
-  if (current.second == nullptr)
-    return *this;
-
-  if (can_erase || current.second->next == nullptr)
-    advance_cursors();
-
-  can_erase = true;
-  return *this;
-}
-
-//KLUDGE: creates garbage! (can return local value!)
-template<class T>
-const ics::Iterator<T>& HashSet<T>::Iterator::operator ++ (int) {
-  if (expected_mod_count != ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::operator ++(int)");
-
-  Iterator* to_return = new Iterator(*this);
-  if (current.second == nullptr)
-    return *to_return;
-
-  if (can_erase || current.second->next == nullptr)
-    advance_cursors();
-
-  can_erase = true;
-  return *to_return;
-}
-
-template<class T>
-bool HashSet<T>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
-  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
-  if (rhsASI == 0)
-    throw IteratorTypeError("HashSet::Iterator::operator ==");
-  if (expected_mod_count != ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::operator ==");
-  if (ref_set != rhsASI->ref_set)
-    throw ComparingDifferentIteratorsError("HashSet::Iterator::operator ==");
-
-  return this->current.second == rhsASI->current.second;
-}
-
-
-template<class T>
-bool HashSet<T>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
-  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
-  if (rhsASI == 0)
-    throw IteratorTypeError("HashSet::Iterator::operator !=");
-  if (expected_mod_count != ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::operator !=");
-  if (ref_set != rhsASI->ref_set)
-    throw ComparingDifferentIteratorsError("HashSet::Iterator::operator !=");
-
-  return this->current.second != rhsASI->current.second;
-}
-
-template<class T>
-T& HashSet<T>::Iterator::operator *() const {
-  if (expected_mod_count !=
-      ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::operator *");
-  if (!can_erase || current.second == nullptr)
-    throw IteratorPositionIllegal("HashSet::Iterator::operator * Iterator illegal: exhausted");
-
-  return current.second->value;
-}
-
-template<class T>
-T* HashSet<T>::Iterator::operator ->() const {
-  if (expected_mod_count !=
-      ref_set->mod_count)
-    throw ConcurrentModificationError("HashSet::Iterator::operator *");
-  if (!can_erase || current.second == nullptr)
-    throw IteratorPositionIllegal("HashSet::Iterator::operator * Iterator illegal: exhausted");
-
-  return &(current.second->value);
-}
-
-}
-
-#endif /* HASH_SET_HPP_ */
+#ifndef HASH_SET_HPP_
+#define HASH_SET_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <type_traits>
+#include <functional>
+#include <cstddef>
+#include <cmath>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "pair.hpp"
+#include "iterator.hpp"
+#include "node_pool.hpp"
+#include "hash_code.hpp"
+#include "bin_policy.hpp"
+#include "set.hpp"
+
+
+namespace ics {
+
+//HASH and EQUALS are function objects (or function pointer types) called as
+//  hash(element) -> std::size_t and equals(element1,element2) -> bool; by
+//  default std::hash<T> and std::equal_to<T> (i.e., T's ==)
+//  The constructors take the objects to call (ahash/aequals), which must be
+//  supplied for function pointers or function objects with state
+//NODE_POOL allocates all LNs: ics::NodePool (the default) carves them from
+//  slabs and recycles erased ones; ics::NewDeletePool uses plain new/delete
+//CACHE_HASH stores each element's hash code in its LN (see HashCode): by
+//  default only for non-scalar elements (e.g., std::string)
+//BIN_POLICY sizes the bins and compresses hash codes into them (see
+//  bin_policy.hpp): ics::ModuloBins (the default) allows any # of bins and
+//  uses %; ics::MaskBins and ics::FibonacciBins keep bins a power of 2 so no
+//  division is needed
+template<class T,class HASH = std::hash<T>,class EQUALS = std::equal_to<T>,
+         template<class> class NODE_POOL = ics::NodePool,bool CACHE_HASH = !std::is_scalar<T>::value,
+         class BIN_POLICY = ics::ModuloBins>
+class HashSet : public Set<T>	{
+  public:
+    explicit HashSet(const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+    HashSet(int initial_bins, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+    HashSet(const HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& to_copy);
+    HashSet(HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& to_move);
+    HashSet(std::initializer_list<T> il, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+    HashSet(ics::Iterator<T>& start, const ics::Iterator<T>& stop, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS(), double the_load_factor = 1.0);
+    virtual ~HashSet();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual bool contains   (const T& element) const;
+    virtual std::string str () const;
+
+    virtual bool contains (ics::Iterator<T>& start, const ics::Iterator<T>& stop) const;
+
+    virtual int  insert (const T& element);
+    template<class... Args>
+    int          emplace (Args&&... args); //insert(T(args...)), moving the new value in
+    virtual int  erase  (const T& element);
+    virtual void clear  ();
+
+    virtual int insert (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> insert (const ITERATOR& start, const ITERATOR& stop);
+    virtual int erase  (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    virtual int retain (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+
+    //reserve: enough bins (and pooled LNs) for n elements without rehashing;
+    //  shrink_to_fit: the fewest bins allowed by the load factor, and a new
+    //  pool holding only the live LNs
+    void reserve       (int n);
+    void shrink_to_fit ();
+
+    virtual HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& operator = (const HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& rhs);
+    virtual HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& operator = (HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& rhs);
+    virtual bool operator == (const Set<T>& rhs) const;
+    virtual bool operator != (const Set<T>& rhs) const;
+    virtual bool operator <= (const Set<T>& rhs) const;
+    virtual bool operator <  (const Set<T>& rhs) const;
+    virtual bool operator >= (const Set<T>& rhs) const;
+    virtual bool operator >  (const Set<T>& rhs) const;
+
+    template<class T2,class HASH2,class EQUALS2,template<class> class NODE_POOL2,bool CACHE_HASH2,class BIN_POLICY2>
+    friend std::ostream& operator << (std::ostream& outs, const HashSet<T2,HASH2,EQUALS2,NODE_POOL2,CACHE_HASH2,BIN_POLICY2>& s);
+
+    virtual ics::Iterator<T>& ibegin () const;
+    virtual ics::Iterator<T>& iend   () const;
+
+  private:
+    class LN;
+
+  public:
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>* iterate_over, bool begin);
+        Iterator(const Iterator& i);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        ics::pair<int,LN*> current; //Bin Index and Cursor; stop: LN* == nullptr
+        HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*        ref_set;
+        int                expected_mod_count;
+        bool               can_erase = true;
+        void advance_cursors();
+    };
+
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    class LN : public HashCode<CACHE_HASH> {
+      public:
+        LN ()                                           : next(nullptr){}
+        LN (const LN& ln)                               : HashCode<CACHE_HASH>(ln), value(ln.value), next(ln.next){}
+        LN (const LN& ln, LN* n)                        : HashCode<CACHE_HASH>(ln), value(ln.value), next(n){}
+        LN (T v,  LN* n = nullptr, std::size_t code = 0) : HashCode<CACHE_HASH>(code), value(std::move(v)), next(n){}
+        LN& operator = (const LN& ln) = default;
+        LN& operator = (LN&& ln)      = default;
+
+        T   value;
+        LN* next;
+    };
+
+    NODE_POOL<LN> pool;           //Allocates every LN (sentinels too)
+    LN** set      = nullptr;
+    HASH   hash;
+    EQUALS equals;
+    double load_factor;//used/bins <= load_factor
+    int bins      = 1; //# bins in array
+    int used      = 0; //# of key->value pairs in the hash table
+    int mod_count = 0; //For sensing concurrent modification
+    int   hash_compress (std::size_t hash_code) const;
+    int   bins_for (int n) const;
+    void  ensure_load_factor(int new_used);
+    void  rehash (int new_bins);
+    LN*   find_element (const T& element, std::size_t hash_code) const;
+    LN*   copy_list(LN*   l);
+    LN**  copy_hash_table(LN** ht, int bins);
+    void  delete_hash_table(LN**& ht, int bins);
+    void  swap_contents (HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& other);
+  };
+
+
+
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashSet(const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  set = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+    set[b] = pool.make();
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashSet(int initial_bins, const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : bins(BIN_POLICY::round_bins(initial_bins)), hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  set = new LN*[bins];
+  pool.reserve(bins);
+  for (int b=0; b<bins; ++b)
+    set[b] = pool.make();
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashSet(const HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& to_copy)
+    : hash(to_copy.hash), equals(to_copy.equals), load_factor(to_copy.load_factor), bins(to_copy.bins), used(to_copy.used) {
+  set  = copy_hash_table(to_copy.set,bins);
+}
+
+//to_move is left with an empty 1-bin table (made by the delegated constructor)
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashSet(HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& to_move)
+    : HashSet(to_move.hash,to_move.equals,to_move.load_factor) {
+  swap_contents(to_move);
+  ++to_move.mod_count;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashSet(ics::Iterator<T>& start, const ics::Iterator<T>& stop, const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  set = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+    set[b] = pool.make();
+  insert(start,stop);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::HashSet(std::initializer_list<T> il,const HASH& ahash, const EQUALS& aequals, double the_load_factor)
+    : hash(ahash), equals(aequals), load_factor(the_load_factor) {
+  set = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+    set[b] = pool.make();
+  for (T s_elem : il)
+    insert(s_elem);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::~HashSet() {
+  delete_hash_table(set,bins);
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+inline bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::empty() const {
+  return used == 0;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::size() const {
+  return used;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::contains (const T& element) const {
+  return find_element(element,hash(element)) != nullptr;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+std::string HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::str() const {
+  std::ostringstream answer;
+  if (bins == 0)
+    answer << "empty";
+  else
+    answer << std::endl;
+    for (int b=0; b<bins; ++b) {
+      answer << "bin[" << b << "] = ";
+      for (LN* c = set[b]; c->next!=nullptr; c=c->next)
+        answer << c->value << " -> " ;
+      answer << "#" << std::endl;
+    }
+  answer  << "(load_factor=" << load_factor << ",bins=" << bins << ",used=" <<used <<",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::contains(ics::Iterator<T>& start, const ics::Iterator<T>& stop) const {
+  for (; start != stop; ++start)
+    if (!contains(*start))
+      return false;
+
+  return true;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::insert(const T& element) {
+  std::size_t code = hash(element);
+  LN* c = find_element(element,code);
+  if (c != nullptr)
+      return 0;
+
+  ensure_load_factor(used+1);
+  int bin = hash_compress(code);  //bins may have changed
+  set[bin] = pool.make(element,set[bin],code);
+  ++used;
+  ++mod_count;
+  return 1;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+template<class... Args>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::emplace(Args&&... args) {
+  T element(std::forward<Args>(args)...);
+  std::size_t code = hash(element);
+  LN* c = find_element(element,code);
+  if (c != nullptr)
+      return 0;
+
+  ensure_load_factor(used+1);
+  int bin = hash_compress(code);  //bins may have changed
+  set[bin] = pool.make(std::move(element),set[bin],code);
+  ++used;
+  ++mod_count;
+  return 1;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::erase(const T& element) {
+  LN* c = find_element(element,hash(element));
+  if (c == nullptr)
+    return 0;
+
+  LN* to_delete = c->next;
+  *c = std::move(*(c->next));
+  pool.release(to_delete);
+  --used;
+  ++mod_count;
+  return 1;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::clear() {
+  for (int b=0; b<bins; ++b) {
+    LN* l=set[b];
+    for (; l->next!=nullptr; /*See body*/) {
+      LN* to_delete = l;
+      l = l->next;
+      pool.release(to_delete);
+    }
+    set[b] = l;
+  }
+
+  used = 0;
+  ++mod_count;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::insert(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += insert(*start);
+
+  return count;
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+template<class ITERATOR>
+auto HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::insert (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i)
+    count += insert(*i);
+
+  return count;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::erase(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += erase(*start);
+  return count;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::retain(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY> s(start,stop,hash);
+  int count = 0;
+  for (int b=0; b<bins; ++b)
+    for (LN* c=set[b]; c->next!=nullptr; /*See body*/) {
+      if (s.contains(c->value))
+        c = c-> next;
+      else{
+        LN* to_delete = c->next;
+        *c = *(c->next);
+        pool.release(to_delete);
+        ++count;
+      }
+    }
+
+  used -= count;
+  return count;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator = (const HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& rhs) {
+  if (this == &rhs)
+    return *this;
+
+  delete_hash_table(set,bins);
+  set         = copy_hash_table(rhs.set,rhs.bins);
+  hash        = rhs.hash;
+  equals      = rhs.equals;
+  load_factor = rhs.load_factor;
+  bins        = rhs.bins;
+  used        = rhs.used;
+
+  ++mod_count;
+  return *this;
+}
+
+//rhs gets (and later deletes) this set's old table and LNs
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator = (HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>&& rhs) {
+  swap_contents(rhs);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator == (const Set<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+
+  for (int b=0; b<bins; ++b)
+    for (LN* c=set[b]; c->next!=nullptr; c=c->next)
+       if (!rhs.contains(c->value))
+         return false;
+
+  return true;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator != (const Set<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator <= (const Set<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used > rhs.size())
+    return false;
+  for (int b=0; b<bins; ++b)
+    for (LN* c=set[b]; c->next!=nullptr; c=c->next)
+      if (!rhs.contains(c->value))
+        return false;
+
+  return true;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator < (const Set<T>& rhs) const {
+  if (this == &rhs)
+    return false;
+  if (used >= rhs.size())
+    return false;
+  for (int b=0; b<bins; ++b)
+    for (LN* c=set[b]; c->next!=nullptr; c=c->next)
+      if (!rhs.contains(c->value))
+        return false;
+
+  return true;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator >= (const Set<T>& rhs) const {
+  return rhs <= *this;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::operator > (const Set<T>& rhs) const {
+  return rhs < *this;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+std::ostream& operator << (std::ostream& outs, const HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& s) {
+  if (s.empty()) {
+    outs << "set[]";
+  }else{
+    outs << "set[";
+    bool first = true;
+    for (const T& v : s) {
+      outs << (first ? "" : ",") << v;
+      first = false;
+    }
+    outs << "]";
+  }
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),true));
+}
+
+//KLUDGE: memory-leak
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),false));
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::begin () const -> HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator {
+  return Iterator(const_cast<HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),true);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+auto HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::end () const -> HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator {
+  return Iterator(const_cast<HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>*>(this),false);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+inline int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::hash_compress (std::size_t hash_code) const {
+  return BIN_POLICY::compress(hash_code,bins);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::ensure_load_factor(int new_used) {
+  if (double(new_used)/double(bins) <= load_factor)
+    return;
+  rehash(2*bins);
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::rehash(int new_bins) {
+  LN** old_set  = set;
+  int  old_bins = bins;
+
+  bins = new_bins;
+  set = new LN*[bins];
+
+  pool.reserve(bins);  //All new sentinels come from one slab
+  for (int b=0; b<bins; ++b)
+    set[b] = pool.make();
+
+  for (int b=0; b<old_bins; ++b) {
+    LN* c=old_set[b];
+    for (; c->next!=nullptr; /*See body*/) {
+      int bin = hash_compress(c->recall(hash,c->value));
+      LN* to_move = c;
+      c = c->next;
+      to_move->next = set[bin];
+      set[bin] = to_move;
+    }
+    pool.release(c);
+  }
+  delete [] old_set;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+int HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::bins_for(int n) const {
+  return BIN_POLICY::round_bins(int(std::ceil(double(n)/load_factor)));
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::reserve(int n) {
+  int new_bins = bins_for(n);
+  if (new_bins > bins) {
+    rehash(new_bins);
+    ++mod_count;
+  }
+  pool.reserve(n-used);
+}
+
+//Remake every LN (including the sentinels) in a new pool, so all the slabs
+//  holding erased LNs are returned to the heap
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::shrink_to_fit() {
+  int new_bins = bins_for(used);
+
+  NODE_POOL<LN> new_pool;
+  new_pool.reserve(new_bins+used);
+  LN** new_set = new LN*[new_bins];
+  for (int b=0; b<new_bins; ++b)
+    new_set[b] = new_pool.make();
+
+  for (int b=0; b<bins; ++b)
+    for (LN* c = set[b]; c != nullptr; /*See body*/) {
+      if (c->next != nullptr) {
+        int bin = BIN_POLICY::compress(c->recall(hash,c->value),new_bins);
+        new_set[bin] = new_pool.make(*c,new_set[bin]);
+      }
+      LN* to_release = c;
+      c = c->next;
+      pool.release(to_release);
+    }
+  delete [] set;
+
+  set  = new_set;
+  bins = new_bins;
+  pool.swap(new_pool);
+  ++mod_count;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN* HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::find_element (const T& element, std::size_t hash_code) const {
+  for (LN* c = set[hash_compress(hash_code)]; c->next!=nullptr; c=c->next)
+    if (c->may_equal(hash_code) && equals(element,c->value))
+      return c;
+
+  return nullptr;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN* HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::copy_list (LN* l) {
+  if (l == nullptr)
+    return nullptr;
+  else
+    return pool.make(*l, copy_list(l->next));
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+typename HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::LN** HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::copy_hash_table (LN** ht, int bins) {
+  LN** answer = new LN*[bins];
+  for (int b=0; b<bins; ++b)
+     answer[b] = copy_list(ht[b]);
+  return answer;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::delete_hash_table (LN**& ht, int bins) {
+  for (int b=0; b<bins; ++b)
+    for (LN* c=ht[b]; c!=nullptr; /*See body*/) {
+      LN* to_delete = c;
+      c = c->next;
+      pool.release(to_delete);
+  }
+  delete[] ht;
+  ht = nullptr;
+}
+
+//Exchange everything but mod_count (each set keeps counting its own changes)
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::swap_contents (HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>& other) {
+  pool.swap(other.pool);
+  std::swap(set,         other.set);
+  std::swap(hash,        other.hash);
+  std::swap(equals,      other.equals);
+  std::swap(load_factor, other.load_factor);
+  std::swap(bins,        other.bins);
+  std::swap(used,        other.used);
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+void HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::advance_cursors(){
+  if (current.second != nullptr && current.second->next != nullptr && current.second->next->next != nullptr) {
+    current.second = current.second->next;
+    return;
+  }else
+    for (int b=current.first+1; b<ref_set->bins; ++b)
+      if (ref_set->set[b]->next != nullptr) {
+        current.first  = b;
+        current.second = ref_set->set[b];
+        return;
+      }
+  current.first  = -1;
+  current.second = nullptr;
+}
+
+
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::Iterator(HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>* iterate_over, bool begin) : ref_set(iterate_over) {
+  current = ics::pair<int,LN*>(-1,nullptr);
+  if (begin)
+     advance_cursors();
+  expected_mod_count = ref_set->mod_count;
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::Iterator(const Iterator& i) :
+    current(i.current), ref_set(i.ref_set), expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::~Iterator()
+{}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+T HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::erase() {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("HashSet::Iterator::erase Iterator cursor already erased");
+  if (current.second == nullptr)
+    throw CannotEraseError("HashSet::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  T to_return = current.second->value;
+  LN* to_delete = current.second->next;
+
+  *current.second = *(current.second->next);
+  --ref_set->used;
+  ++ref_set->mod_count;
+  expected_mod_count = ref_set->mod_count;
+  ref_set->pool.release(to_delete);
+
+  return to_return;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+std::string HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_set->str() << "(current=" << current.first << "/" << current.second << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+const ics::Iterator<T>& HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator ++ () {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::operator ++");
+
+  if (current.second == nullptr)
+    return *this;
+
+  if (can_erase || current.second->next == nullptr)
+    advance_cursors();
+
+  can_erase = true;
+  return *this;
+}
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+const ics::Iterator<T>& HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator ++ (int) {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::operator ++(int)");
+
+  Iterator* to_return = new Iterator(*this);
+  if (current.second == nullptr)
+    return *to_return;
+
+  if (can_erase || current.second->next == nullptr)
+    advance_cursors();
+
+  can_erase = true;
+  return *to_return;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("HashSet::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::operator ==");
+  if (ref_set != rhs.ref_set)
+    throw ComparingDifferentIteratorsError("HashSet::Iterator::operator ==");
+
+  return this->current.second == rhs.current.second;
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("HashSet::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+bool HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::operator !=");
+  if (ref_set != rhs.ref_set)
+    throw ComparingDifferentIteratorsError("HashSet::Iterator::operator !=");
+
+  return this->current.second != rhs.current.second;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+T& HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator *() const {
+  if (expected_mod_count !=
+      ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::operator *");
+  if (!can_erase || current.second == nullptr)
+    throw IteratorPositionIllegal("HashSet::Iterator::operator * Iterator illegal: exhausted");
+
+  return current.second->value;
+}
+
+template<class T,class HASH,class EQUALS,template<class> class NODE_POOL,bool CACHE_HASH,class BIN_POLICY>
+T* HashSet<T,HASH,EQUALS,NODE_POOL,CACHE_HASH,BIN_POLICY>::Iterator::operator ->() const {
+  if (expected_mod_count !=
+      ref_set->mod_count)
+    throw ConcurrentModificationError("HashSet::Iterator::operator *");
+  if (!can_erase || current.second == nullptr)
+    throw IteratorPositionIllegal("HashSet::Iterator::operator * Iterator illegal: exhausted");
+
+  return &(current.second->value);
+}
+
+}
+
+#endif /* HASH_SET_HPP_ */
@@ -1,463 +1,830 @@
-#ifndef HEAP_PRIORITY_QUEUE_HPP_
-#define HEAP_PRIORITY_QUEUE_HPP_
-
-#include <string>
-#include <iostream>
-#include <sstream>
-#include <initializer_list>
-#include "ics_exceptions.hpp"
-#include "iterator.hpp"
-#include "priority_queue.hpp"
-#include <utility>              //For std::swap function
-#include "array_stack.hpp"
-
-
-namespace ics {
-
-template<class T> class HeapPriorityQueue : public PriorityQueue<T>  {
-  using PriorityQueue<T>::gt;  //Required because of templated classes
-  public:
-    HeapPriorityQueue() = delete;
-    explicit HeapPriorityQueue(bool (*agt)(const T& a, const T& b));
-    HeapPriorityQueue(int initialLength,bool (*agt)(const T& a, const T& b));
-    HeapPriorityQueue(const HeapPriorityQueue<T>& to_copy);
-    HeapPriorityQueue(std::initializer_list<T> il,bool (*agt)(const T& a, const T& b));
-    HeapPriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop,bool (*agt)(const T& a, const T& b));
-    virtual ~HeapPriorityQueue();
-
-    virtual bool empty      () const;
-    virtual int  size       () const;
-    virtual T&   peek       () const;
-    virtual std::string str () const;
-
-    virtual int  enqueue (const T& element);
-    virtual T    dequeue ();
-    virtual void clear   ();
-
-    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
-
-    virtual HeapPriorityQueue<T>& operator = (const HeapPriorityQueue<T>& rhs);
-    virtual bool operator == (const PriorityQueue<T>& rhs) const;
-    virtual bool operator != (const PriorityQueue<T>& rhs) const;
-
-    template<class T2>
-    friend std::ostream& operator << (std::ostream& outs, const HeapPriorityQueue<T2>& p);
-
-    virtual ics::Iterator<T>& ibegin() const;
-    virtual ics::Iterator<T>& iend  () const;
-
-    class Iterator : public ics::Iterator<T> {
-      public:
-        //KLUDGE should be callable only in begin/end
-        Iterator(HeapPriorityQueue<T>* iterate_over, bool begin);
-        Iterator(const Iterator& i);
-        virtual ~Iterator();
-        virtual T           erase();
-        virtual std::string str  () const;
-        virtual const ics::Iterator<T>& operator ++ ();
-        virtual const ics::Iterator<T>& operator ++ (int);
-        virtual bool operator == (const ics::Iterator<T>& rhs) const;
-        virtual bool operator != (const ics::Iterator<T>& rhs) const;
-        virtual T& operator *  () const;
-        virtual T* operator -> () const;
-      private:
-        HeapPriorityQueue<T>  it;          //Copy of pq to use as iterator via dequeue
-        HeapPriorityQueue<T>* ref_pq;
-        int                   expected_mod_count;
-        bool                  can_erase = true;
-    };
-
-    virtual Iterator begin() const;
-    virtual Iterator end  () const;
-
-  private:
-    //See base class PriorityQueue
-    //bool (*gt)(const T& a, const T& b);// gt(a,b) = true iff a has higher priority than b
-    T*  pq;
-    int  length    = 0;                  //Physical length of array (must be > .size()
-    int  used      = 0;                  //Amount of array used
-    int  mod_count = 0;                  //For sensing concurrent modification
-    void ensure_length(int new_length);
-    int  left_child     (int i);         //Useful abstractions for heaps as arrays
-    int  right_child    (int i);
-    int  parent         (int i);
-    bool is_root        (int i);
-    bool in_heap        (int i);
-    void percolate_up   (int i);
-    void percolate_down (int i);
-  };
-
-
-
-
-
-template<class T>
-HeapPriorityQueue<T>::HeapPriorityQueue(bool (*agt)(const T& a, const T& b)) : PriorityQueue<T>(agt) {
-  pq = new T[length];
-}
-
-template<class T>
-HeapPriorityQueue<T>::HeapPriorityQueue(int initial_length, bool (*agt)(const T& a, const T& b))
-  : PriorityQueue<T>(agt), length(initial_length) {
-  if (length < 0)
-    length = 0;
-  pq = new T[length];
-}
-
-template<class T>
-HeapPriorityQueue<T>::HeapPriorityQueue(const HeapPriorityQueue<T>& to_copy)
-  : PriorityQueue<T>(to_copy.gt), length(to_copy.length), used(to_copy.used) {
-  pq = new T[length];
-  for (int i=0; i<to_copy.used; ++i)
-    pq[i] = to_copy.pq[i];
-}
-
-template<class T>
-HeapPriorityQueue<T>::HeapPriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop, bool (*agt)(const T& a, const T& b))
-  : PriorityQueue<T>(agt) {
-  pq = new T[length];
-  while (start != stop) {
-    this->ensure_length(used+1);
-    pq[used++] = *start;
-    ++start;
-  }
-  for (int i=used-1; i>=0; --i)
-    percolate_down(i);
-}
-
-template<class T>
-HeapPriorityQueue<T>::HeapPriorityQueue(std::initializer_list<T> il, bool (*agt)(const T& a, const T& b))
-  : PriorityQueue<T>(agt) {
-  pq = new T[length];
-  for (T pq_elem : il)
-    enqueue(pq_elem);
-}
-
-
-template<class T>
-HeapPriorityQueue<T>::~HeapPriorityQueue() {
-  delete[] pq;
-}
-
-
-template<class T>
-inline bool HeapPriorityQueue<T>::empty() const {
-  return used == 0;
-}
-
-template<class T>
-int HeapPriorityQueue<T>::size() const {
-  return used;
-}
-
-template<class T>
-T& HeapPriorityQueue<T>::peek () const {
-  if (empty())
-    throw EmptyError("HeapPriorityQueue::peek");
-
-  return pq[0];
-}
-
-template<class T>
-std::string HeapPriorityQueue<T>::str() const {
-  std::ostringstream answer;
-  if (empty()) {
-    answer << "priority_queue[]";
-  }else{
-    answer << "priority_queue[";
-    for (int i=0; i<used-1; ++i)
-      answer << pq[i] << ",";
-    answer << pq[used-1] << "]";
-  }
-  answer << "(length=" << length << ",used=" << used << ",mod_count=" << mod_count << ")";
-  return answer.str();
-}
-
-template<class T>
-int HeapPriorityQueue<T>::enqueue(const T& element) {
-  this->ensure_length(used+1);
-  pq[used++] = element;
-
-  percolate_up(used-1);
-  ++mod_count;
-  return 1;
-}
-
-template<class T>
-T HeapPriorityQueue<T>::dequeue() {
-  if (this->empty())
-    throw EmptyError("HeapPriorityQueue::dequeue");
-  T to_return = pq[0];
-  pq[0] = pq[--used];
-
-  percolate_down(0);
-
-  ++mod_count;
-  return to_return;
-}
-
-template<class T>
-void HeapPriorityQueue<T>::clear() {
-  used = 0;
-  ++mod_count;
-}
-
-template<class T>
-int HeapPriorityQueue<T>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
-  int count = 0;
-  for (; start != stop; ++start)
-    count += enqueue(*start);
-
-  return count;
-}
-
-template<class T>
-HeapPriorityQueue<T>& HeapPriorityQueue<T>::operator = (const HeapPriorityQueue<T>& rhs) {
-  if (this == &rhs)
-    return *this;
-  this->ensure_length(rhs.used);
-  gt   = rhs.gt;
-  used = rhs.used;
-  for (int i=0; i<used; ++i)
-    pq[i] = rhs.pq[i];
-  ++mod_count;
-  return *this;
-}
-
-template<class T>
-bool HeapPriorityQueue<T>::operator == (const PriorityQueue<T>& rhs) const {
-  if (this == &rhs)
-    return true;
-  if (used != rhs.size())
-    return false;
-  //KLUDGE: should check for == function used to prioritize, but cannot unless
-  //  this is made part of the PriorityQueue class (should it be? protected)?
-  ics::Iterator<T> &l = this->ibegin(), &r = rhs.ibegin();
-  for (int i=0; i<used; ++i, ++l, ++r)
-    if (*l != *r)
-      return false;
-
-  return true;
-}
-
-template<class T>
-bool HeapPriorityQueue<T>::operator != (const PriorityQueue<T>& rhs) const {
-  return !(*this == rhs);
-}
-
-template<class T>
-std::ostream& operator << (std::ostream& outs, const HeapPriorityQueue<T>& p) {
-  if (p.empty()) {
-    outs << "priority_queue[]";
-  }else{
-    outs << "priority_queue[";
-    ArrayStack<T> temp(p.ibegin(), p.iend());
-    for (int i=0; i<p.used-1; ++i)
-      outs << temp.pop() << ",";
-    outs << temp.pop() << "]:highest";
-  }
-  return outs;
-}
-
-//KLUDGE: memory-leak
-template<class T>
-auto HeapPriorityQueue<T>::ibegin () const -> ics::Iterator<T>& {
-  return *(new Iterator(const_cast<HeapPriorityQueue<T>*>(this),true));
-}
-
-//KLUDGE: memory-leak
-template<class T>
-auto HeapPriorityQueue<T>::iend () const -> ics::Iterator<T>& {
-  return *(new Iterator(const_cast<HeapPriorityQueue<T>*>(this),false));
-}
-
-template<class T>
-auto HeapPriorityQueue<T>::begin () const -> HeapPriorityQueue<T>::Iterator {
-  return Iterator(const_cast<HeapPriorityQueue<T>*>(this),true);
-}
-
-template<class T>
-auto HeapPriorityQueue<T>::end () const -> HeapPriorityQueue<T>::Iterator {
-  return Iterator(const_cast<HeapPriorityQueue<T>*>(this),false);
-}
-
-
-template<class T>
-void HeapPriorityQueue<T>::ensure_length(int new_length) {
-  if (length >= new_length)
-    return;
-  T*  old_pq  = pq;
-  length = std::max(new_length,2*length);
-  pq = new T[length];
-  for (int i=0; i<used; ++i)
-    pq[i] = old_pq[i];
-
-  delete [] old_pq;
-}
-
-template<class T>
-int HeapPriorityQueue<T>::left_child(int i)
-{return 2*i+1;}
-
-template<class T>
-int HeapPriorityQueue<T>::right_child(int i)
-{return 2*i+2;}
-
-template<class T>
-int HeapPriorityQueue<T>::parent(int i)
-{return (i-1)/2;}
-
-template<class T>
-bool HeapPriorityQueue<T>::is_root(int i)
-{return i == 0;}
-
-template<class T>
-bool HeapPriorityQueue<T>::in_heap(int i)
-{return i < used;}
-
-template<class T>
-void HeapPriorityQueue<T>::percolate_up(int i) {
-  for (/*parameter*/; !is_root(i) && gt(pq[i],pq[parent(i)]); i = parent(i))
-    std::swap(pq[parent(i)],pq[i]);
-}
-
-
-template<class T>
-void HeapPriorityQueue<T>::percolate_down(int i) {
-  for (int l = left_child(i); in_heap(l); l = left_child(i)) {
-    int r = right_child(i);
-    int max = !in_heap(r) || gt(pq[l],pq[r]) ? l : r;
-    if ( gt(pq[i],pq[max]) )
-       break;
-    std::swap(pq[i],pq[max]);
-    i = max;
-  }
-}
-
-
-
-template<class T>
-HeapPriorityQueue<T>::Iterator::Iterator(HeapPriorityQueue<T>* iterate_over, bool begin) : it(nullptr), ref_pq(iterate_over) {
-  if (begin)
-    it = *iterate_over;
-  expected_mod_count = ref_pq->mod_count;
-}
-
-template<class T>
-HeapPriorityQueue<T>::Iterator::Iterator(const Iterator& i) :
-    it(i.it), ref_pq(i.ref_pq), expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {}
-
-template<class T>
-HeapPriorityQueue<T>::Iterator::~Iterator()
-{}
-
-template<class T>
-T HeapPriorityQueue<T>::Iterator::erase() {
-  if (expected_mod_count != ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::erase");
-  if (!can_erase)
-    throw CannotEraseError("HeapPriorityQueue::Iterator::erase Iterator cursor already erased");
-  if (it.empty())
-    throw CannotEraseError("HeapPriorityQueue::Iterator::erase Iterator cursor beyond data structure");
-
-  can_erase = false;
-  T to_return = it.peek();
-
-  for (int i=0; i<ref_pq->used; ++i)
-    if (ref_pq->pq[i] == to_return) {
-      ref_pq->pq[i] = ref_pq->pq[--ref_pq->used];
-      ref_pq->percolate_up(i);
-      ref_pq->percolate_down(i);
-      break;
-    }
-
-  expected_mod_count = ref_pq->mod_count;
-  return to_return;
-}
-
-template<class T>
-std::string HeapPriorityQueue<T>::Iterator::str() const {
-  std::ostringstream answer;
-  answer << it.str() << "/expected_mod_count=" << expected_mod_count << "/can_erase=" << can_erase;
-  return answer.str();
-}
-
-
-template<class T>
-const ics::Iterator<T>& HeapPriorityQueue<T>::Iterator::operator ++ () {
-  if (expected_mod_count != ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator ++");
-
-  if (!it.empty())
-    it.dequeue();
-
-  can_erase = true;
-  return *this;
-}
-
-//KLUDGE: creates garbage! (can return local value!)
-template<class T>
-const ics::Iterator<T>& HeapPriorityQueue<T>::Iterator::operator ++ (int) {
-  if (expected_mod_count != ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator ++(int)");
-
-  Iterator* to_return = new Iterator(*this);
-  if (!it.empty())
-    it.dequeue();
-
-  can_erase = true;
-  return *to_return;
-}
-
-template<class T>
-bool HeapPriorityQueue<T>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
-  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
-  if (rhsASI == 0)
-    throw IteratorTypeError("HeapPriorityQueue::Iterator::operator ==");
-  if (expected_mod_count != ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator ==");
-  if (ref_pq != rhsASI->ref_pq)
-    throw ComparingDifferentIteratorsError("HeapPriorityQueue::Iterator::operator ==");
-
-  return this->it.size() == rhsASI->it.size();
-}
-
-
-template<class T>
-bool HeapPriorityQueue<T>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
-  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
-  if (rhsASI == 0)
-    throw IteratorTypeError("HeapPriorityQueue::Iterator::operator !=");
-  if (expected_mod_count != ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator !=");
-  if (ref_pq != rhsASI->ref_pq)
-    throw ComparingDifferentIteratorsError("HeapPriorityQueue::Iterator::operator !=");
-
-  return this->it.size() != rhsASI->it.size();
-}
-
-template<class T>
-T& HeapPriorityQueue<T>::Iterator::operator *() const {
-  if (expected_mod_count !=
-      ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator *");
-  if (!can_erase || it.empty())
-    throw IteratorPositionIllegal("HeapPriorityQueue::Iterator::operator * Iterator illegal: exhausted");
-
-  return it.peek();
-}
-
-template<class T>
-T* HeapPriorityQueue<T>::Iterator::operator ->() const {
-  if (expected_mod_count !=
-      ref_pq->mod_count)
-    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator *");
-  if (!can_erase || it.empty())
-    throw IteratorPositionIllegal("HeapPriorityQueue::Iterator::operator -> Iterator illegal: exhausted");
-
-  return &it.peek();
-}
-
-}
-
-#endif /* HEAP_PRIORITY_QUEUE_HPP_ */
+#ifndef HEAP_PRIORITY_QUEUE_HPP_
+#define HEAP_PRIORITY_QUEUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "priority_queue.hpp"
+#include <utility>              //For std::swap function
+#include <algorithm>
+#include "array_stack.hpp"
+
+
+namespace ics {
+
+//ARITY is the # of children of each node in the heap (e.g., 2, 4, 8): larger
+//  arities make the heap shallower, so enqueue compares less, and keep the
+//  children dequeue compares adjacent in memory, but dequeue compares more
+//  children at each level.
+template<class T,int ARITY = 2> class HeapPriorityQueue : public PriorityQueue<T>  {
+  static_assert(ARITY >= 2, "HeapPriorityQueue: ARITY must be at least 2");
+  using PriorityQueue<T>::gt;  //Required because of templated classes
+  public:
+    HeapPriorityQueue() = delete;
+    explicit HeapPriorityQueue(bool (*agt)(const T& a, const T& b));
+    HeapPriorityQueue(int initialLength,bool (*agt)(const T& a, const T& b));
+    HeapPriorityQueue(const HeapPriorityQueue<T,ARITY>& to_copy);
+    HeapPriorityQueue(HeapPriorityQueue<T,ARITY>&& to_move);
+    HeapPriorityQueue(std::initializer_list<T> il,bool (*agt)(const T& a, const T& b));
+    HeapPriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop,bool (*agt)(const T& a, const T& b));
+    virtual ~HeapPriorityQueue();
+
+    //Adopt array (allocated by new T[length]; the queue deletes it) and
+    //  arrange its values into a heap where they are, in O(length) time
+    static HeapPriorityQueue<T,ARITY> from_array(T* array, int length, bool (*agt)(const T& a, const T& b));
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual T&   peek       () const;
+    virtual std::string str () const;
+
+    virtual int  enqueue (const T& element);
+    template<class... Args>
+    int          emplace (Args&&... args); //enqueue(T(args...)), moving the new value in
+    virtual T    dequeue ();
+    virtual void clear   ();
+
+    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> enqueue (const ITERATOR& start, const ITERATOR& stop);
+
+    void reserve       (int n); //Room for n values without reallocating
+    void shrink_to_fit ();      //Release the unused part of the array
+
+    virtual HeapPriorityQueue<T,ARITY>& operator = (const HeapPriorityQueue<T,ARITY>& rhs);
+    virtual HeapPriorityQueue<T,ARITY>& operator = (HeapPriorityQueue<T,ARITY>&& rhs);
+    virtual bool operator == (const PriorityQueue<T>& rhs) const;
+    virtual bool operator != (const PriorityQueue<T>& rhs) const;
+
+    template<class T2,int ARITY2>
+    friend std::ostream& operator << (std::ostream& outs, const HeapPriorityQueue<T2,ARITY2>& p);
+
+    virtual ics::Iterator<T>& ibegin() const;
+    virtual ics::Iterator<T>& iend  () const;
+
+    //Iterators visit values in priority order (highest first) without copying
+    //  the heap: they search it top-down, keeping a frontier heap of the
+    //  positions (not values) that can be visited next. Iterators from
+    //  unordered() visit the heap's array in index order and cannot erase.
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(HeapPriorityQueue<T,ARITY>* iterate_over, bool begin, bool in_order = true);
+        Iterator(const Iterator& i);
+        Iterator(Iterator&& i);
+        Iterator& operator = (Iterator i);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        //Ordered: every visited position's parent was visited; frontier holds
+        //  the unvisited positions whose parents were, current excepted
+        HeapPriorityQueue<T,ARITY>* ref_pq;
+        int                   current;               //Position in ref_pq->pq; -1 when exhausted
+        bool                  ordered;
+        int*                  frontier        = nullptr;  //A heap of positions, by gt on their values
+        int                   frontier_length = 0;
+        int                   frontier_used   = 0;
+        int                   expected_mod_count;
+        bool                  can_erase = true;
+        void advance       ();
+        void push_children (int i);
+        void push_frontier (int i);
+        int  pop_frontier  ();
+        void erase_frontier(int i);
+        bool visited       (int i) const;
+    };
+
+    virtual Iterator begin() const;
+    virtual Iterator end  () const;
+
+    //For implicit use in array (not priority) order: for (... i : c.unordered())...
+    class Unordered {
+      public:
+        explicit Unordered(const HeapPriorityQueue<T,ARITY>* iterate_over) : ref_pq(iterate_over) {}
+        Iterator begin () const;
+        Iterator end   () const;
+      private:
+        const HeapPriorityQueue<T,ARITY>* ref_pq;
+    };
+
+    Unordered unordered () const;
+
+  private:
+    //See base class PriorityQueue
+    //bool (*gt)(const T& a, const T& b);// gt(a,b) = true iff a has higher priority than b
+    T*  pq;
+    int  length    = 0;                  //Physical length of array (must be > .size()
+    int  used      = 0;                  //Amount of array used
+    int  mod_count = 0;                  //For sensing concurrent modification
+    void ensure_length(int new_length);
+    void reallocate   (int new_length);
+    int  first_child    (int i);         //Useful abstractions for heaps as arrays
+    int  last_child     (int i);         //  (which may not be in_heap)
+    int  highest_child  (int i);         //i's child with the highest priority (i has one)
+    int  parent         (int i);
+    bool is_root        (int i);
+    bool in_heap        (int i);
+    void percolate_up   (int i);
+    void percolate_down (int i);
+    void heapify        ();              //Whole array, bottom-up: O(used)
+    void restore_heap   (int old_used);  //After appending values at [old_used,used)
+  };
+
+
+
+
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::HeapPriorityQueue(bool (*agt)(const T& a, const T& b)) : PriorityQueue<T>(agt) {
+  pq = new T[length];
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::HeapPriorityQueue(int initial_length, bool (*agt)(const T& a, const T& b))
+  : PriorityQueue<T>(agt), length(initial_length) {
+  if (length < 0)
+    length = 0;
+  pq = new T[length];
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::HeapPriorityQueue(const HeapPriorityQueue<T,ARITY>& to_copy)
+  : PriorityQueue<T>(to_copy.gt), length(to_copy.length), used(to_copy.used) {
+  pq = new T[length];
+  for (int i=0; i<to_copy.used; ++i)
+    pq[i] = to_copy.pq[i];
+}
+
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::HeapPriorityQueue(HeapPriorityQueue<T,ARITY>&& to_move)
+  : PriorityQueue<T>(to_move.gt), pq(to_move.pq), length(to_move.length), used(to_move.used) {
+  to_move.pq = nullptr;   //to_move is left empty, with length 0
+  to_move.length = 0;
+  to_move.used = 0;
+  ++to_move.mod_count;
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::HeapPriorityQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop, bool (*agt)(const T& a, const T& b))
+  : PriorityQueue<T>(agt) {
+  pq = new T[length];
+  while (start != stop) {
+    this->ensure_length(used+1);
+    pq[used++] = *start;
+    ++start;
+  }
+  heapify();
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::HeapPriorityQueue(std::initializer_list<T> il, bool (*agt)(const T& a, const T& b))
+  : PriorityQueue<T>(agt), length(il.size()) {
+  pq = new T[length];
+  for (const T& pq_elem : il)
+    pq[used++] = pq_elem;
+  heapify();
+}
+
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY> HeapPriorityQueue<T,ARITY>::from_array(T* array, int length, bool (*agt)(const T& a, const T& b)) {
+  HeapPriorityQueue<T,ARITY> answer(agt);
+  delete[] answer.pq;
+  answer.pq     = array;
+  answer.length = answer.used = length < 0 ? 0 : length;
+  answer.heapify();
+  return answer;
+}
+
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::~HeapPriorityQueue() {
+  delete[] pq;
+}
+
+
+template<class T,int ARITY>
+inline bool HeapPriorityQueue<T,ARITY>::empty() const {
+  return used == 0;
+}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::size() const {
+  return used;
+}
+
+template<class T,int ARITY>
+T& HeapPriorityQueue<T,ARITY>::peek () const {
+  if (empty())
+    throw EmptyError("HeapPriorityQueue::peek");
+
+  return pq[0];
+}
+
+template<class T,int ARITY>
+std::string HeapPriorityQueue<T,ARITY>::str() const {
+  std::ostringstream answer;
+  if (empty()) {
+    answer << "priority_queue[]";
+  }else{
+    answer << "priority_queue[";
+    for (int i=0; i<used-1; ++i)
+      answer << pq[i] << ",";
+    answer << pq[used-1] << "]";
+  }
+  answer << "(length=" << length << ",used=" << used << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::enqueue(const T& element) {
+  this->ensure_length(used+1);
+  pq[used++] = element;
+
+  percolate_up(used-1);
+  ++mod_count;
+  return 1;
+}
+
+
+template<class T,int ARITY>
+template<class... Args>
+int HeapPriorityQueue<T,ARITY>::emplace(Args&&... args) {
+  this->ensure_length(used+1);
+  pq[used++] = T(std::forward<Args>(args)...);
+
+  percolate_up(used-1);
+  ++mod_count;
+  return 1;
+}
+
+template<class T,int ARITY>
+T HeapPriorityQueue<T,ARITY>::dequeue() {
+  if (this->empty())
+    throw EmptyError("HeapPriorityQueue::dequeue");
+  T to_return = std::move(pq[0]);
+  pq[0] = std::move(pq[--used]);
+
+  percolate_down(0);
+
+  ++mod_count;
+  return to_return;
+}
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::clear() {
+  used = 0;
+  ++mod_count;
+}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int old_used = used;
+  for (; start != stop; ++start) {
+    this->ensure_length(used+1);
+    pq[used++] = *start;
+  }
+
+  restore_heap(old_used);
+  return used-old_used;
+}
+
+
+template<class T,int ARITY>
+template<class ITERATOR>
+auto HeapPriorityQueue<T,ARITY>::enqueue (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int old_used = used;
+  for (ITERATOR i = start; i != stop; ++i) {
+    this->ensure_length(used+1);
+    pq[used++] = *i;
+  }
+
+  restore_heap(old_used);
+  return used-old_used;
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>& HeapPriorityQueue<T,ARITY>::operator = (const HeapPriorityQueue<T,ARITY>& rhs) {
+  if (this == &rhs)
+    return *this;
+  this->ensure_length(rhs.used);
+  gt   = rhs.gt;
+  used = rhs.used;
+  for (int i=0; i<used; ++i)
+    pq[i] = rhs.pq[i];
+  ++mod_count;
+  return *this;
+}
+
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>& HeapPriorityQueue<T,ARITY>::operator = (HeapPriorityQueue<T,ARITY>&& rhs) {
+  std::swap(pq,    rhs.pq);  //rhs gets (and later deletes) the old array
+  std::swap(length,rhs.length);
+  std::swap(used,  rhs.used);
+  std::swap(gt,    rhs.gt);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::operator == (const PriorityQueue<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+  //KLUDGE: should check for == function used to prioritize, but cannot unless
+  //  this is made part of the PriorityQueue class (should it be? protected)?
+  const HeapPriorityQueue<T,ARITY>* rhsHPQ = dynamic_cast<const HeapPriorityQueue<T,ARITY>*>(&rhs);
+  if (rhsHPQ != nullptr) {
+    for (Iterator l = begin(), r = rhsHPQ->begin(); l != end(); ++l, ++r)
+      if (*l != *r)
+        return false;
+    return true;
+  }
+
+  bool answer = true;
+  ics::Iterator<T>& r = rhs.ibegin();
+  for (Iterator l = begin(); answer && l != end(); ++l, ++r)
+    answer = !(*l != *r);
+  delete &r;  //ibegin returns a heap-allocated iterator
+  return answer;
+}
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::operator != (const PriorityQueue<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+template<class T,int ARITY>
+std::ostream& operator << (std::ostream& outs, const HeapPriorityQueue<T,ARITY>& p) {
+  if (p.empty()) {
+    outs << "priority_queue[]";
+  }else{
+    outs << "priority_queue[";
+    ArrayStack<const T*> temp(p.used);
+    for (const T& v : p)
+      temp.push(&v);
+    for (int i=0; i<p.used-1; ++i)
+      outs << *temp.pop() << ",";
+    outs << *temp.pop() << "]:highest";
+  }
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<HeapPriorityQueue<T,ARITY>*>(this),true));
+}
+
+//KLUDGE: memory-leak
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<HeapPriorityQueue<T,ARITY>*>(this),false));
+}
+
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::begin () const -> HeapPriorityQueue<T,ARITY>::Iterator {
+  return Iterator(const_cast<HeapPriorityQueue<T,ARITY>*>(this),true);
+}
+
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::end () const -> HeapPriorityQueue<T,ARITY>::Iterator {
+  return Iterator(const_cast<HeapPriorityQueue<T,ARITY>*>(this),false);
+}
+
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::unordered () const -> HeapPriorityQueue<T,ARITY>::Unordered {
+  return Unordered(this);
+}
+
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::Unordered::begin () const -> HeapPriorityQueue<T,ARITY>::Iterator {
+  return Iterator(const_cast<HeapPriorityQueue<T,ARITY>*>(ref_pq),true,false);
+}
+
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::Unordered::end () const -> HeapPriorityQueue<T,ARITY>::Iterator {
+  return Iterator(const_cast<HeapPriorityQueue<T,ARITY>*>(ref_pq),false,false);
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::ensure_length(int new_length) {
+  if (length >= new_length)
+    return;
+  reallocate(std::max(new_length,2*length));
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::reallocate(int new_length) {
+  T*  old_pq  = pq;
+  length = new_length;
+  pq = new T[length];
+  for (int i=0; i<used; ++i)
+    pq[i] = std::move(old_pq[i]);
+
+  delete [] old_pq;
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::reserve(int n) {
+  if (length < n)
+    reallocate(n);
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::shrink_to_fit() {
+  if (length > used)
+    reallocate(used);
+}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::first_child(int i)
+{return ARITY*i+1;}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::last_child(int i)
+{return ARITY*i+ARITY;}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::highest_child(int i) {
+  int max  = first_child(i);
+  int stop = std::min(last_child(i)+1,used);
+  for (int c = max+1; c < stop; ++c)
+    if (gt(pq[c],pq[max]))
+      max = c;
+  return max;
+}
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::parent(int i)
+{return (i-1)/ARITY;}
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::is_root(int i)
+{return i == 0;}
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::in_heap(int i)
+{return i < used;}
+
+
+//Both percolates move the value out of the array once and slide the values
+//  it passes over into the hole (one move per level, not a 3-move swap)
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::percolate_up(int i) {
+  if (is_root(i) || !gt(pq[i],pq[parent(i)]))
+    return;
+  T value = std::move(pq[i]);
+  for (/*parameter*/; !is_root(i) && gt(value,pq[parent(i)]); i = parent(i))
+    pq[i] = std::move(pq[parent(i)]);
+  pq[i] = std::move(value);
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::percolate_down(int i) {
+  if (!in_heap(first_child(i)))
+    return;
+  T value = std::move(pq[i]);
+  for (/*parameter*/; in_heap(first_child(i)); /*See body*/) {
+    int max = highest_child(i);
+    if ( gt(value,pq[max]) )
+       break;
+    pq[i] = std::move(pq[max]);
+    i = max;
+  }
+  pq[i] = std::move(value);
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::heapify() {
+  for (int i=parent(used-1); i>=0; --i)
+    percolate_down(i);
+}
+
+
+//Percolating each new value up costs up to depth compares apiece; rebuilding
+//  the heap costs about 2*used compares in all, so it wins for big batches
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::restore_heap(int old_used) {
+  if (used == old_used)
+    return;
+
+  int depth = 0;
+  for (int n=used; n > 1; n /= ARITY)
+    ++depth;
+  if ((long long)(used-old_used)*depth <= 2LL*used)
+    for (int i=old_used; i<used; ++i)
+      percolate_up(i);
+  else
+    heapify();
+
+  ++mod_count;
+}
+
+
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::Iterator::Iterator(HeapPriorityQueue<T,ARITY>* iterate_over, bool begin, bool in_order)
+  : ref_pq(iterate_over), current(begin && !iterate_over->empty() ? 0 : -1), ordered(in_order) {
+  expected_mod_count = ref_pq->mod_count;
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::Iterator::Iterator(const Iterator& i) :
+    ref_pq(i.ref_pq), current(i.current), ordered(i.ordered),
+    frontier_length(i.frontier_used), frontier_used(i.frontier_used),
+    expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {
+  if (frontier_length > 0) {
+    frontier = new int[frontier_length];
+    for (int f=0; f<frontier_used; ++f)
+      frontier[f] = i.frontier[f];
+  }
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::Iterator::Iterator(Iterator&& i) :
+    ref_pq(i.ref_pq), current(i.current), ordered(i.ordered), frontier(i.frontier),
+    frontier_length(i.frontier_length), frontier_used(i.frontier_used),
+    expected_mod_count(i.expected_mod_count), can_erase(i.can_erase) {
+  i.frontier = nullptr;
+  i.frontier_length = i.frontier_used = 0;
+}
+
+//i is a copy (or was moved from an rvalue); it deletes this iterator's old frontier
+template<class T,int ARITY>
+auto HeapPriorityQueue<T,ARITY>::Iterator::operator = (Iterator i) -> Iterator& {
+  std::swap(ref_pq,            i.ref_pq);
+  std::swap(current,           i.current);
+  std::swap(ordered,           i.ordered);
+  std::swap(frontier,          i.frontier);
+  std::swap(frontier_length,   i.frontier_length);
+  std::swap(frontier_used,     i.frontier_used);
+  std::swap(expected_mod_count,i.expected_mod_count);
+  std::swap(can_erase,         i.can_erase);
+  return *this;
+}
+
+template<class T,int ARITY>
+HeapPriorityQueue<T,ARITY>::Iterator::~Iterator() {
+  delete[] frontier;
+}
+
+//Removing current (at position p) keeps every visited value visited and
+//  every unvisited value unvisited: if the last position was unvisited, the
+//  hole at p sinks through p's (unvisited) subtree to a leaf that the last
+//  value fills, and p is then an unvisited frontier position; otherwise the
+//  (visited) last value fills p, which stays visited, and p's children join
+//  the frontier. Values unvisited never have higher priority than visited
+//  ones, so percolating up never moves one past the other.
+template<class T,int ARITY>
+T HeapPriorityQueue<T,ARITY>::Iterator::erase() {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("HeapPriorityQueue::Iterator::erase Iterator cursor already erased");
+  if (current < 0)
+    throw CannotEraseError("HeapPriorityQueue::Iterator::erase Iterator cursor beyond data structure");
+  if (!ordered)
+    throw CannotEraseError("HeapPriorityQueue::Iterator::erase Iterator is unordered");
+
+  can_erase = false;
+  T* pq = ref_pq->pq;
+  T to_return = std::move(pq[current]);
+  int last = --ref_pq->used;
+
+  if (current != last) {
+    if (!visited(last)) {
+      erase_frontier(last);
+      int hole = current;
+      while (ref_pq->in_heap(ref_pq->first_child(hole))) {
+        int max = ref_pq->highest_child(hole);
+        pq[hole] = std::move(pq[max]);
+        hole = max;
+      }
+      if (hole != last) {
+        pq[hole] = std::move(pq[last]);
+        ref_pq->percolate_up(hole);
+      }
+      push_frontier(current);
+    }else{
+      pq[current] = std::move(pq[last]);
+      ref_pq->percolate_up(current);
+      push_children(current);
+    }
+  }
+
+  ++ref_pq->mod_count;
+  expected_mod_count = ref_pq->mod_count;
+  return to_return;
+}
+
+template<class T,int ARITY>
+std::string HeapPriorityQueue<T,ARITY>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_pq->str() << "/current=" << current << "/ordered=" << ordered << "/frontier=[";
+  for (int f=0; f<frontier_used; ++f)
+    answer << (f == 0 ? "" : ",") << frontier[f];
+  answer << "]/expected_mod_count=" << expected_mod_count << "/can_erase=" << can_erase;
+  return answer.str();
+}
+
+
+template<class T,int ARITY>
+const ics::Iterator<T>& HeapPriorityQueue<T,ARITY>::Iterator::operator ++ () {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator ++");
+
+  advance();
+  return *this;
+}
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T,int ARITY>
+const ics::Iterator<T>& HeapPriorityQueue<T,ARITY>::Iterator::operator ++ (int) {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator ++(int)");
+
+  Iterator* to_return = new Iterator(*this);
+  advance();
+  return *to_return;
+}
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("HeapPriorityQueue::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator ==");
+  if (ref_pq != rhs.ref_pq)
+    throw ComparingDifferentIteratorsError("HeapPriorityQueue::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("HeapPriorityQueue::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator !=");
+  if (ref_pq != rhs.ref_pq)
+    throw ComparingDifferentIteratorsError("HeapPriorityQueue::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+template<class T,int ARITY>
+T& HeapPriorityQueue<T,ARITY>::Iterator::operator *() const {
+  if (expected_mod_count !=
+      ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator *");
+  if (!can_erase || current < 0)
+    throw IteratorPositionIllegal("HeapPriorityQueue::Iterator::operator * Iterator illegal: exhausted");
+
+  return ref_pq->pq[current];
+}
+
+template<class T,int ARITY>
+T* HeapPriorityQueue<T,ARITY>::Iterator::operator ->() const {
+  if (expected_mod_count !=
+      ref_pq->mod_count)
+    throw ConcurrentModificationError("HeapPriorityQueue::Iterator::operator *");
+  if (!can_erase || current < 0)
+    throw IteratorPositionIllegal("HeapPriorityQueue::Iterator::operator -> Iterator illegal: exhausted");
+
+  return &ref_pq->pq[current];
+}
+
+
+//After an erase, erase has already updated the frontier
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::Iterator::advance() {
+  if (current < 0)
+    return;
+
+  if (!ordered)
+    current = current+1 < ref_pq->used ? current+1 : -1;
+  else{
+    if (can_erase)
+      push_children(current);
+    current = pop_frontier();
+  }
+  can_erase = true;
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::Iterator::push_children(int i) {
+  for (int c = ref_pq->first_child(i); c <= ref_pq->last_child(i); ++c)
+    if (ref_pq->in_heap(c))
+      push_frontier(c);
+}
+
+
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::Iterator::push_frontier(int i) {
+  if (frontier_used == frontier_length) {
+    frontier_length = std::max(4,2*frontier_length);
+    int* old_frontier = frontier;
+    frontier = new int[frontier_length];
+    for (int f=0; f<frontier_used; ++f)
+      frontier[f] = old_frontier[f];
+    delete[] old_frontier;
+  }
+
+  const T* pq = ref_pq->pq;
+  int f = frontier_used++;
+  for (/*See above*/; f > 0 && ref_pq->gt(pq[i],pq[frontier[(f-1)/2]]); f = (f-1)/2)
+    frontier[f] = frontier[(f-1)/2];
+  frontier[f] = i;
+}
+
+
+template<class T,int ARITY>
+int HeapPriorityQueue<T,ARITY>::Iterator::pop_frontier() {
+  if (frontier_used == 0)
+    return -1;
+
+  const T* pq = ref_pq->pq;
+  int answer = frontier[0];
+  int moved  = frontier[--frontier_used];
+  int f = 0;
+  for (int l = 1; l < frontier_used; l = 2*f+1) {
+    int max = l+1 < frontier_used && ref_pq->gt(pq[frontier[l+1]],pq[frontier[l]]) ? l+1 : l;
+    if (!ref_pq->gt(pq[frontier[max]],pq[moved]))
+      break;
+    frontier[f] = frontier[max];
+    f = max;
+  }
+  frontier[f] = moved;
+  return answer;
+}
+
+
+//Only erase removes from inside the frontier (rarely): rebuild it without i
+template<class T,int ARITY>
+void HeapPriorityQueue<T,ARITY>::Iterator::erase_frontier(int i) {
+  int old_used = frontier_used;
+  frontier_used = 0;
+  for (int f=0; f<old_used; ++f)
+    if (frontier[f] != i)
+      push_frontier(frontier[f]);
+}
+
+
+//Position i was visited iff it is current, or its parent was visited and
+//  then expanded (is not current) and i is no longer in the frontier
+template<class T,int ARITY>
+bool HeapPriorityQueue<T,ARITY>::Iterator::visited(int i) const {
+  if (i == current || ref_pq->is_root(i))
+    return true;
+  int p = ref_pq->parent(i);
+  if (p == current || !visited(p))
+    return false;
+  for (int f=0; f<frontier_used; ++f)
+    if (frontier[f] == i)
+      return false;
+  return true;
+}
+
+}
+
+#endif /* HEAP_PRIORITY_QUEUE_HPP_ */
@@ -1,37 +1,49 @@
-#ifndef ITERATOR_HPP_
-#define ITERATOR_HPP_
-
-#include <string>
-
-namespace ics {
-
-template<class T>
-class Iterator {
-  public:
-    virtual ~Iterator(){}
-    virtual T           erase() = 0;
-    virtual std::string str  () const = 0;
-    virtual const Iterator<T>& operator ++ ()    = 0;
-    virtual const Iterator<T>& operator ++ (int) = 0;
-    virtual bool operator == (const Iterator<T>& rhs) const = 0;
-    virtual bool operator != (const Iterator<T>& rhs) const = 0;
-    virtual T& operator *  () const  = 0;
-    virtual T* operator -> () const = 0;
-
-    template<class T2>
-    friend std::ostream& operator << (std::ostream& outs, const Iterator<T2>& s);
-};
-
-
-
-
-
-template<class T2>
-std::ostream& operator << (std::ostream& outs, const Iterator<T2>& s) {
-  outs << s.str(); //Same as debugging
-  return outs;
-}
-
-}
-
-#endif /* ITERATOR_HPP_ */
+#ifndef ITERATOR_HPP_
+#define ITERATOR_HPP_
+
+#include <string>
+#include <type_traits>
+
+namespace ics {
+
+template<class T>
+class Iterator {
+  public:
+    virtual ~Iterator(){}
+    virtual T           erase() = 0;
+    virtual std::string str  () const = 0;
+    virtual const Iterator<T>& operator ++ ()    = 0;
+    virtual const Iterator<T>& operator ++ (int) = 0;
+    virtual bool operator == (const Iterator<T>& rhs) const = 0;
+    virtual bool operator != (const Iterator<T>& rhs) const = 0;
+    virtual T& operator *  () const  = 0;
+    virtual T* operator -> () const = 0;
+
+    template<class T2>
+    friend std::ostream& operator << (std::ostream& outs, const Iterator<T2>& s);
+};
+
+
+//The concrete Iterator nested in each data structure (returned by value from
+//  begin()/end()) is final, so code templated on its type calls ++, *, and
+//  != directly (no virtual calls, no dynamic_cast, no heap allocation).
+//if_concrete_iterator<IT,T> is int when IT is such a type and otherwise
+//  removes a member template from overloading (e.g., so m.put(k,v) is never
+//  mistaken for putting the range [k,v) when k and v have the same type).
+template<class IT,class T>
+using if_concrete_iterator =
+  typename std::enable_if<std::is_base_of<Iterator<T>,IT>::value && !std::is_abstract<IT>::value,int>::type;
+
+
+
+
+
+template<class T2>
+std::ostream& operator << (std::ostream& outs, const Iterator<T2>& s) {
+  outs << s.str(); //Same as debugging
+  return outs;
+}
+
+}
+
+#endif /* ITERATOR_HPP_ */
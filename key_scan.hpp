@@ -0,0 +1,229 @@
+#ifndef KEY_SCAN_HPP_
+#define KEY_SCAN_HPP_
+
+#include <type_traits>
+#include <utility>
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+
+namespace ics {
+
+//A linear scan for the index of a key in an array of keys, used by the
+//  array-based data structures (e.g., ArrayMap, ArraySet):
+//    scan_keys(keys,n,key) -> the smallest i in [0,n) with keys[i] == key, or -1
+//Keys whose == compares their bytes (integers, enums, pointers) are compared
+//  many at a time: 16 bytes per SSE2 compare where available, otherwise in
+//  blocks of 8 without a branch per key. Other keys are compared one at a
+//  time with their ==.
+//A second scan finds a key stored as the first of an array of pairs (e.g.,
+//  the entries of an ArrayMap):
+//    scan_entry_keys(entries,n,key) -> the smallest i in [0,n) with
+//                                      entries[i].first == key, or -1
+//  When each pair is exactly two scannable keys long, SSE2 compares 16 bytes
+//  of pairs at a time and ignores the lanes holding the seconds.
+
+
+//Integer, enum, and pointer types: == on them is equality of their bytes
+template<class K>
+class is_scannable_key : public std::integral_constant<bool,
+    (std::is_integral<K>::value || std::is_enum<K>::value || std::is_pointer<K>::value) &&
+    (sizeof(K) == 1 || sizeof(K) == 2 || sizeof(K) == 4 || sizeof(K) == 8)> {};
+
+
+namespace key_scan {
+
+//SIZE is sizeof(K) for scannable keys, 0 for all others
+template<class K>
+using Size = std::integral_constant<int,is_scannable_key<K>::value ? int(sizeof(K)) : 0>;
+
+
+template<class K>
+int scan (const K* keys, int n, const K& key, std::integral_constant<int,0>) {
+  for (int i=0; i<n; ++i)
+    if (keys[i] == key)
+      return i;
+
+  return -1;
+}
+
+
+inline int lowest_bit (unsigned mask) {
+#if defined(__GNUC__)
+  return __builtin_ctz(mask);
+#else
+  int answer = 0;
+  for (; (mask & 1) == 0; mask >>= 1)
+    ++answer;
+  return answer;
+#endif
+}
+
+
+#if defined(__SSE2__)
+inline __m128i equal_lanes (__m128i a, __m128i b, std::integral_constant<int,1>) {return _mm_cmpeq_epi8 (a,b);}
+inline __m128i equal_lanes (__m128i a, __m128i b, std::integral_constant<int,2>) {return _mm_cmpeq_epi16(a,b);}
+inline __m128i equal_lanes (__m128i a, __m128i b, std::integral_constant<int,4>) {return _mm_cmpeq_epi32(a,b);}
+
+//SSE2 has no 64-bit compare: both 32-bit halves of a lane must be equal
+inline __m128i equal_lanes (__m128i a, __m128i b, std::integral_constant<int,8>) {
+  __m128i halves = _mm_cmpeq_epi32(a,b);
+  return _mm_and_si128(halves,_mm_shuffle_epi32(halves,_MM_SHUFFLE(2,3,0,1)));
+}
+
+
+//Each compare sets all the bytes of the lanes that are equal; movemask
+//  gathers one bit per byte, so the first set bit / SIZE is the first match
+template<class K,int SIZE>
+int scan (const K* keys, int n, const K& key, std::integral_constant<int,SIZE> size) {
+  const int PER_BLOCK = 16/SIZE;
+  K lanes[PER_BLOCK];
+  for (int j=0; j<PER_BLOCK; ++j)
+    lanes[j] = key;
+  __m128i all_key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+
+  int i = 0;
+  for (/*See above*/; i+PER_BLOCK <= n; i += PER_BLOCK) {
+    __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(keys+i));
+    unsigned mask = unsigned(_mm_movemask_epi8(equal_lanes(block,all_key,size)));
+    if (mask != 0)
+      return i + lowest_bit(mask)/SIZE;
+  }
+  for (/*See above*/; i<n; ++i)
+    if (keys[i] == key)
+      return i;
+
+  return -1;
+}
+
+#else
+
+//Compare a block of 8 keys into a bit mask, then test the mask once
+template<class K,int SIZE>
+int scan (const K* keys, int n, const K& key, std::integral_constant<int,SIZE>) {
+  int i = 0;
+  for (/*See above*/; i+8 <= n; i += 8) {
+    unsigned mask = 0;
+    for (int j=0; j<8; ++j)
+      mask |= unsigned(keys[i+j] == key) << j;
+    if (mask != 0)
+      return i + lowest_bit(mask);
+  }
+  for (/*See above*/; i<n; ++i)
+    if (keys[i] == key)
+      return i;
+
+  return -1;
+}
+#endif
+
+
+template<class E,class K>
+int scan_entries (const E* entries, int n, const K& key, std::integral_constant<int,0>) {
+  for (int i=0; i<n; ++i)
+    if (entries[i].first == key)
+      return i;
+
+  return -1;
+}
+
+
+#if defined(__SSE2__)
+inline int lowest_bit (unsigned long long mask) {
+#if defined(__GNUC__)
+  return __builtin_ctzll(mask);
+#else
+  int answer = 0;
+  for (; (mask & 1) == 0; mask >>= 1)
+    ++answer;
+  return answer;
+#endif
+}
+
+
+//The movemask bits of the bytes holding firsts: the low SIZE of every 2*SIZE
+inline unsigned long long first_bytes (std::integral_constant<int,1>) {return 0x5555555555555555ULL;}
+inline unsigned long long first_bytes (std::integral_constant<int,2>) {return 0x3333333333333333ULL;}
+inline unsigned long long first_bytes (std::integral_constant<int,4>) {return 0x0F0F0F0F0F0F0F0FULL;}
+inline unsigned long long first_bytes (std::integral_constant<int,8>) {return 0x00FF00FF00FF00FFULL;}
+
+
+//Compare 64 bytes of entries (4 loads) per iteration, gathering the four
+//  16-bit movemasks into one 64-bit mask; the first set bit of the firsts'
+//  bytes / (2*SIZE) is the first match. n must be a multiple of 64/(2*SIZE).
+template<class E,class K,int SIZE>
+int scan_entry_blocks (const E* entries, int n, const K& key, std::integral_constant<int,SIZE> size) {
+  const int PER_LANE  = 16/SIZE;
+  const int PER_BLOCK = 64/(2*SIZE);
+  K lanes[PER_LANE];
+  for (int j=0; j<PER_LANE; ++j)
+    lanes[j] = key;
+  __m128i all_key = _mm_loadu_si128(reinterpret_cast<const __m128i*>(lanes));
+  const unsigned long long firsts = first_bytes(size);
+
+  for (int i=0; i<n; i += PER_BLOCK) {
+    const __m128i* block = reinterpret_cast<const __m128i*>(entries+i);
+    unsigned long long mask =
+       (unsigned long long)unsigned(_mm_movemask_epi8(equal_lanes(_mm_loadu_si128(block),  all_key,size)))        |
+      ((unsigned long long)unsigned(_mm_movemask_epi8(equal_lanes(_mm_loadu_si128(block+1),all_key,size))) << 16) |
+      ((unsigned long long)unsigned(_mm_movemask_epi8(equal_lanes(_mm_loadu_si128(block+2),all_key,size))) << 32) |
+      ((unsigned long long)unsigned(_mm_movemask_epi8(equal_lanes(_mm_loadu_si128(block+3),all_key,size))) << 48);
+    mask &= firsts;
+    if (mask != 0)
+      return i + lowest_bit(mask)/(2*SIZE);
+  }
+
+  return -1;
+}
+
+
+//Kept small so that it is inlined: too few entries for a block (the common
+//  case for small maps) costs no more than the plain loop
+template<class E,class K,int SIZE>
+inline int scan_entries (const E* entries, int n, const K& key, std::integral_constant<int,SIZE> size) {
+  const int blocks_end = n - n%(64/(2*SIZE));
+  if (blocks_end > 0) {
+    int answer = scan_entry_blocks(entries,blocks_end,key,size);
+    if (answer != -1)
+      return answer;
+  }
+  for (int i=blocks_end; i<n; ++i)
+    if (entries[i].first == key)
+      return i;
+
+  return -1;
+}
+
+
+//SIZE is sizeof(K) when an E is exactly a scannable K followed by another
+//  K's worth of bytes (the second and any padding), 0 otherwise
+template<class E,class K>
+using EntrySize = std::integral_constant<int,
+    std::is_standard_layout<E>::value && std::is_trivially_copyable<E>::value &&
+    std::is_same<typename std::remove_cv<decltype(std::declval<E>().first)>::type,K>::value &&
+    sizeof(E) == 2*sizeof(K) ? Size<K>::value : 0>;
+
+#else
+
+template<class E,class K>
+using EntrySize = std::integral_constant<int,0>;
+#endif
+
+}
+
+
+template<class K>
+inline int scan_keys (const K* keys, int n, const K& key) {
+  return key_scan::scan(keys,n,key,key_scan::Size<K>());
+}
+
+
+template<class E,class K>
+inline int scan_entry_keys (const E* entries, int n, const K& key) {
+  return key_scan::scan_entries(entries,n,key,key_scan::EntrySize<E,K>());
+}
+
+}
+
+#endif /* KEY_SCAN_HPP_ */
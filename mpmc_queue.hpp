@@ -0,0 +1,706 @@
+#ifndef MPMC_QUEUE_HPP_
+#define MPMC_QUEUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>
+#include <atomic>
+#include <cstddef>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "queue.hpp"
+#include "concurrency.hpp"
+
+
+namespace ics {
+
+//A bounded queue shared by any number of threads, without locks: any thread
+//  may call enqueue/try_enqueue/wait_enqueue/emplace, dequeue/try_dequeue/
+//  wait_dequeue, clear, and empty/size/capacity (whose answers may be stale
+//  by the time they return).
+//peek is only for when no other thread is dequeueing; all other operations
+//  (copying, assignment, ==, str, <<, iterators) must be used only when no
+//  thread is enqueueing or dequeueing.
+//
+//Each cell in the (power of 2 length) array has a sequence number telling
+//  which enqueue/dequeue may use it next. front/rear count every dequeue/
+//  enqueue (they are never reduced modulo the array length): the enqueue
+//  numbered rear may fill cell rear & mask when the cell's sequence is rear
+//  (otherwise the queue is full, or another thread got there first); it
+//  claims that number with a compare-and-swap on rear, stores the value,
+//  then publishes it by storing sequence rear+1. The dequeue numbered front
+//  may empty cell front & mask when its sequence is front+1; it claims that
+//  number with a compare-and-swap on front, moves the value out, then frees
+//  the cell for the enqueue a lap later by storing sequence front+capacity.
+//So threads contend only on the front (or rear) counter's CAS, never on a
+//  lock, and producers and consumers touch different counters.
+template<class T> class MPMCQueue : public Queue<T>  {
+  public:
+    explicit MPMCQueue(int capacity = 1024); //Rounded up to a power of 2 (>= 2)
+    MPMCQueue(const MPMCQueue<T>& to_copy);
+    MPMCQueue(MPMCQueue<T>&& to_move);
+    MPMCQueue(std::initializer_list<T> il);
+    MPMCQueue(int capacity, ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    virtual ~MPMCQueue();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual T&   peek       () const;
+    virtual std::string str () const;
+    int capacity            () const;
+
+    virtual int  enqueue (const T& element);  //Throws FullError if full
+    template<class... Args>
+    int          emplace (Args&&... args);    //enqueue(T(args...)), moving the new value in
+    virtual T    dequeue ();                  //Throws EmptyError if empty
+    virtual void clear   ();
+
+    //Return false (changing nothing) instead of throwing FullError/EmptyError
+    bool try_enqueue (const T& element);
+    template<class... Args>
+    bool try_emplace (Args&&... args);
+    bool try_dequeue (T& into);
+
+    //Wait (see ics::Backoff) until not full/empty, instead of throwing
+    int  wait_enqueue (const T& element);
+    T    wait_dequeue ();
+
+    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> enqueue (const ITERATOR& start, const ITERATOR& stop);
+
+    virtual MPMCQueue<T>& operator = (const MPMCQueue<T>& rhs);
+    virtual MPMCQueue<T>& operator = (MPMCQueue<T>&& rhs);
+    virtual bool operator == (const Queue<T>& rhs) const;
+    virtual bool operator != (const Queue<T>& rhs) const;
+
+    template<class T2>
+    friend std::ostream& operator << (std::ostream& outs, const MPMCQueue<T2>& q);
+
+  private:
+    class Cell;
+  public:
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(MPMCQueue<T>* iterate_over, std::size_t initial);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        std::size_t   current;  //if can_erase is false, this value is unusable
+        MPMCQueue<T>* ref_queue;
+        std::size_t   expected_front;     //enqueue/dequeue don't change mod_count
+        std::size_t   expected_rear;      //  (it isn't atomic), but do change these
+        int           expected_mod_count;
+        bool          can_erase = true;
+        bool          is_stale () const;
+    };
+
+    //For explicit use: Iterator<...>& it = c.ibegin(); ... or for (Iterator<...>& it = c.ibegin(); it != c.iend(); ++it)...
+    virtual ics::Iterator<T>& ibegin () const;
+    virtual ics::Iterator<T>& iend   () const;
+
+    //For implicit use: for (... i : c)...
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    class Cell {
+      public:
+        std::atomic<std::size_t> sequence;
+        T                        value;
+    };
+
+    //The padding keeps the producers' and consumers' counters (and the
+    //  fields both only read) on different cache lines
+    Cell*       cells;
+    std::size_t mask      = 0;  //Array length-1
+    int         mod_count = 0;  //For sensing concurrent modification (by erase/=)
+    char        pad_0[CACHE_LINE_SIZE];
+    std::atomic<std::size_t> rear {0};  //Next enqueue's number
+    char        pad_1[CACHE_LINE_SIZE];
+    std::atomic<std::size_t> front{0};  //Next dequeue's number
+    char        pad_2[CACHE_LINE_SIZE];
+    Cell* claim_rear  ();               //nullptr if full
+    void  publish     (Cell* c);
+    Cell* claim_front ();               //nullptr if empty
+    void  release     (Cell* c);
+    int   erase_at    (std::size_t i);
+    void  reallocate  (int new_capacity);  //Discards all values
+    bool  is_in       (std::size_t i) const;
+    static int rounded_capacity (int capacity);
+  };
+
+
+
+
+
+template<class T>
+MPMCQueue<T>::MPMCQueue(int capacity) : cells(nullptr) {
+  reallocate(capacity);
+}
+
+
+template<class T>
+MPMCQueue<T>::MPMCQueue(const MPMCQueue<T>& to_copy) : MPMCQueue<T>(to_copy.capacity()) {
+  for (const T& q_elem : to_copy)
+    enqueue(q_elem);
+}
+
+
+//to_move is left empty, with capacity 0
+template<class T>
+MPMCQueue<T>::MPMCQueue(MPMCQueue<T>&& to_move) : cells(nullptr) {
+  *this = std::move(to_move);
+}
+
+
+template<class T>
+MPMCQueue<T>::MPMCQueue(int capacity, ics::Iterator<T>& start, const ics::Iterator<T>& stop)
+  : MPMCQueue<T>(capacity) {
+  enqueue(start,stop);
+}
+
+
+template<class T>
+MPMCQueue<T>::MPMCQueue(std::initializer_list<T> il) : MPMCQueue<T>(int(il.size())) {
+  for (const T& q_elem : il)
+    enqueue(q_elem);
+}
+
+
+template<class T>
+MPMCQueue<T>::~MPMCQueue() {
+  delete[] cells;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::empty() const {
+  return this->size() == 0;
+}
+
+
+//front is loaded first: rear only grows, so it is >= any earlier front.
+//  But between the loads other threads may dequeue and enqueue more, so
+//  the answer is capped at the capacity
+template<class T>
+inline int MPMCQueue<T>::size() const {
+  std::size_t f = front.load(std::memory_order_acquire);
+  std::size_t used = rear.load(std::memory_order_acquire) - f;
+  return used > std::size_t(capacity()) ? capacity() : int(used);
+}
+
+
+template<class T>
+T& MPMCQueue<T>::peek () const {
+  std::size_t f = front.load(std::memory_order_acquire);
+  if (cells == nullptr || cells[f & mask].sequence.load(std::memory_order_acquire) != f+1)
+    throw EmptyError("MPMCQueue::peek");
+
+  return cells[f & mask].value;
+}
+
+
+template<class T>
+std::string MPMCQueue<T>::str() const {
+  std::ostringstream answer;
+  answer << "queue[";
+  std::size_t f = front.load(), used = rear.load()-f;
+  for (std::size_t i=0; i<=mask && cells != nullptr; ++i) {
+    if (((i-f) & mask) < used)
+      answer << cells[i].value;
+    answer << (i == mask ? "" : ",");
+  }
+  answer << "](capacity=" << capacity() << ",front=" << front.load() << ",rear=" << rear.load()
+         << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+
+template<class T>
+int MPMCQueue<T>::capacity() const {
+  return cells == nullptr ? 0 : int(mask)+1;
+}
+
+
+template<class T>
+int MPMCQueue<T>::enqueue(const T& element) {
+  if (!try_enqueue(element))
+    throw FullError("MPMCQueue::enqueue");
+  return 1;
+}
+
+
+template<class T>
+template<class... Args>
+int MPMCQueue<T>::emplace(Args&&... args) {
+  if (!try_emplace(std::forward<Args>(args)...))
+    throw FullError("MPMCQueue::emplace");
+  return 1;
+}
+
+
+template<class T>
+T MPMCQueue<T>::dequeue() {
+  T answer;
+  if (!try_dequeue(answer))
+    throw EmptyError("MPMCQueue::dequeue");
+
+  return answer;
+}
+
+
+//Dequeues (and discards) values until empty, so is safe to use concurrently
+template<class T>
+void MPMCQueue<T>::clear() {
+  for (Cell* c = claim_front(); c != nullptr; c = claim_front())
+    release(c);
+}
+
+
+template<class T>
+bool MPMCQueue<T>::try_enqueue(const T& element) {
+  Cell* c = claim_rear();
+  if (c == nullptr)
+    return false;
+
+  c->value = element;
+  publish(c);
+  return true;
+}
+
+
+template<class T>
+template<class... Args>
+bool MPMCQueue<T>::try_emplace(Args&&... args) {
+  Cell* c = claim_rear();
+  if (c == nullptr)
+    return false;
+
+  c->value = T(std::forward<Args>(args)...);
+  publish(c);
+  return true;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::try_dequeue(T& into) {
+  Cell* c = claim_front();
+  if (c == nullptr)
+    return false;
+
+  into = std::move(c->value);
+  release(c);
+  return true;
+}
+
+
+template<class T>
+int MPMCQueue<T>::wait_enqueue(const T& element) {
+  Backoff backoff;
+  while (!try_enqueue(element))
+    backoff.pause();
+  return 1;
+}
+
+
+template<class T>
+T MPMCQueue<T>::wait_dequeue() {
+  T answer;
+  Backoff backoff;
+  while (!try_dequeue(answer))
+    backoff.pause();
+  return answer;
+}
+
+
+template<class T>
+int MPMCQueue<T>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += enqueue(*start);
+
+  return count;
+}
+
+
+template<class T>
+template<class ITERATOR>
+auto MPMCQueue<T>::enqueue (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i)
+    count += enqueue(*i);
+
+  return count;
+}
+
+
+template<class T>
+MPMCQueue<T>& MPMCQueue<T>::operator = (const MPMCQueue<T>& rhs) {
+  if (this == &rhs)
+    return *this;
+  reallocate(rhs.capacity());
+  for (const T& q_elem : rhs)
+    enqueue(q_elem);
+  ++mod_count;
+  return *this;
+}
+
+
+//The atomics can't be swapped, so rhs's are stored here and reset
+template<class T>
+MPMCQueue<T>& MPMCQueue<T>::operator = (MPMCQueue<T>&& rhs) {
+  if (this == &rhs)
+    return *this;
+  delete[] cells;
+  cells = rhs.cells;
+  mask  = rhs.mask;
+  front.store(rhs.front.load());
+  rear.store (rhs.rear.load());
+
+  rhs.cells = nullptr;
+  rhs.mask  = 0;
+  rhs.front.store(0);
+  rhs.rear.store(0);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::operator == (const Queue<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  int used = this->size();
+  if (used != rhs.size())
+    return false;
+  // Uses ! and ==, so != on T need not be defined
+  std::size_t f = front.load();
+  const MPMCQueue<T>* rhsMQ = dynamic_cast<const MPMCQueue<T>*>(&rhs);
+  if (rhsMQ != nullptr) {
+    std::size_t rhs_f = rhsMQ->front.load();
+    for (int i=0; i<used; ++i)
+      if (!(cells[(f+i) & mask].value == rhsMQ->cells[(rhs_f+i) & rhsMQ->mask].value))
+        return false;
+    return true;
+  }
+
+  bool answer = true;
+  ics::Iterator<T>& rhs_i = rhs.ibegin();
+  for (int i=0; answer && i<used; ++i,++rhs_i)
+    answer = cells[(f+i) & mask].value == *rhs_i;
+  delete &rhs_i;  //ibegin returns a heap-allocated iterator
+  return answer;
+}
+
+template<class T>
+bool MPMCQueue<T>::operator != (const Queue<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class T>
+std::ostream& operator << (std::ostream& outs, const MPMCQueue<T>& q) {
+  outs << "queue[";
+
+  std::size_t start = q.front.load(), stop = q.rear.load();
+  for (std::size_t i=start; i!=stop; ++i)
+    outs << (i == start ? "" : ",") << q.cells[i & q.mask].value;
+
+  outs << "]:rear";
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T>
+auto MPMCQueue<T>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<MPMCQueue<T>*>(this),front.load()));
+}
+
+
+//KLUDGE: memory-leak
+template<class T>
+auto MPMCQueue<T>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<MPMCQueue<T>*>(this),rear.load()));
+}
+
+
+template<class T>
+auto MPMCQueue<T>::begin () const -> MPMCQueue<T>::Iterator {
+  return Iterator(const_cast<MPMCQueue<T>*>(this),front.load());
+}
+
+
+template<class T>
+auto MPMCQueue<T>::end () const -> MPMCQueue<T>::Iterator {
+  return Iterator(const_cast<MPMCQueue<T>*>(this),rear.load());
+}
+
+
+//A failed compare_exchange reloads r, so the loop retries with the newest
+//  rear; a cell whose sequence lags r (by a lap) is still full
+template<class T>
+auto MPMCQueue<T>::claim_rear() -> Cell* {
+  if (cells == nullptr)
+    return nullptr;
+
+  std::size_t r = rear.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& c = cells[r & mask];
+    std::ptrdiff_t lag = std::ptrdiff_t(c.sequence.load(std::memory_order_acquire) - r);
+    if (lag == 0) {
+      if (rear.compare_exchange_weak(r,r+1,std::memory_order_relaxed))
+        return &c;
+    }else if (lag < 0)
+      return nullptr;
+    else
+      r = rear.load(std::memory_order_relaxed);
+  }
+}
+
+
+//The cell's number is its sequence (set when it was freed/allocated)
+template<class T>
+void MPMCQueue<T>::publish(Cell* c) {
+  c->sequence.store(c->sequence.load(std::memory_order_relaxed)+1,std::memory_order_release);
+}
+
+
+template<class T>
+auto MPMCQueue<T>::claim_front() -> Cell* {
+  if (cells == nullptr)
+    return nullptr;
+
+  std::size_t f = front.load(std::memory_order_relaxed);
+  for (;;) {
+    Cell& c = cells[f & mask];
+    std::ptrdiff_t lag = std::ptrdiff_t(c.sequence.load(std::memory_order_acquire) - (f+1));
+    if (lag == 0) {
+      if (front.compare_exchange_weak(f,f+1,std::memory_order_relaxed))
+        return &c;
+    }else if (lag < 0)
+      return nullptr;
+    else
+      f = front.load(std::memory_order_relaxed);
+  }
+}
+
+
+//The cell was published with sequence number+1; the next enqueue to use it
+//  is number+capacity
+template<class T>
+void MPMCQueue<T>::release(Cell* c) {
+  c->sequence.store(c->sequence.load(std::memory_order_relaxed)+mask,std::memory_order_release);
+}
+
+
+//Sequences are by position, so only the vacated last cell's changes
+template<class T>
+int MPMCQueue<T>::erase_at(std::size_t i) {
+  std::size_t r = rear.load();
+  for (std::size_t to=i; to+1 != r; ++to)
+    cells[to & mask].value = std::move(cells[(to+1) & mask].value);
+  cells[(r-1) & mask].sequence.store(r-1);
+  rear.store(r-1);
+  ++mod_count;
+  return 1;
+}
+
+
+template<class T>
+void MPMCQueue<T>::reallocate(int new_capacity) {
+  new_capacity = rounded_capacity(new_capacity);
+  if (cells == nullptr || new_capacity != capacity()) {
+    delete[] cells;
+    cells = new Cell[new_capacity];
+    mask  = new_capacity-1;
+  }
+  for (int i=0; i<new_capacity; ++i)
+    cells[i].sequence.store(i,std::memory_order_relaxed);
+  front.store(0);
+  rear.store(0);
+}
+
+
+template<class T>
+bool MPMCQueue<T>::is_in(std::size_t i) const {
+  return i-front.load() < rear.load()-front.load();
+}
+
+
+template<class T>
+int MPMCQueue<T>::rounded_capacity(int capacity) {
+  int answer = 2;
+  while (answer < capacity)
+    answer *= 2;
+  return answer;
+}
+
+
+
+
+
+template<class T>
+MPMCQueue<T>::Iterator::Iterator(MPMCQueue<T>* iterate_over, std::size_t initial) : current(initial), ref_queue(iterate_over) {
+  expected_front     = ref_queue->front.load();
+  expected_rear      = ref_queue->rear.load();
+  expected_mod_count = ref_queue->mod_count;
+}
+
+template<class T>
+MPMCQueue<T>::Iterator::~Iterator() {}
+
+template<class T>
+T MPMCQueue<T>::Iterator::erase() {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("MPMCQueue::Iterator::erase Iterator cursor already erased");
+  if (!ref_queue->is_in(current))
+    throw CannotEraseError("MPMCQueue::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  T to_return = ref_queue->cells[current & ref_queue->mask].value;
+  ref_queue->erase_at(current);
+  expected_rear      = ref_queue->rear.load();
+  expected_mod_count = ref_queue->mod_count;
+  return to_return;
+}
+
+
+template<class T>
+std::string MPMCQueue<T>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_queue->str() << "(current=" << current << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+
+template<class T>
+const ics::Iterator<T>& MPMCQueue<T>::Iterator::operator ++ () {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::operator ++");
+
+  if (current == ref_queue->rear.load())
+    return *this;
+
+  if (!can_erase)
+    can_erase = true;
+  else
+    ++current;
+
+  return *this;
+}
+
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T>
+const ics::Iterator<T>& MPMCQueue<T>::Iterator::operator ++ (int) {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::operator ++(int)");
+
+  if (current == ref_queue->rear.load())
+    return *this;
+
+  Iterator* to_return = new Iterator(*this);
+  if (!can_erase)
+    can_erase = true;
+  else
+    ++current;
+
+  return *to_return;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("MPMCQueue::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::Iterator::operator == (const Iterator& rhs) const {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::operator ==");
+  if (ref_queue != rhs.ref_queue)
+    throw ComparingDifferentIteratorsError("MPMCQueue::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("MPMCQueue::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::Iterator::operator != (const Iterator& rhs) const {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::operator !=");
+  if (ref_queue != rhs.ref_queue)
+    throw ComparingDifferentIteratorsError("MPMCQueue::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+
+template<class T>
+T& MPMCQueue<T>::Iterator::operator *() const {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::operator *");
+  if (!can_erase || !ref_queue->is_in(current)) {
+    std::ostringstream where;
+    where << current << " when front = " << ref_queue->front.load() << " and rear = " << ref_queue->rear.load();
+    throw IteratorPositionIllegal("MPMCQueue::Iterator::operator * Iterator illegal: "+where.str());
+  }
+
+  return ref_queue->cells[current & ref_queue->mask].value;
+}
+
+
+template<class T>
+T* MPMCQueue<T>::Iterator::operator ->() const {
+  if (is_stale())
+    throw ConcurrentModificationError("MPMCQueue::Iterator::operator ->");
+  if (!can_erase || !ref_queue->is_in(current)) {
+    std::ostringstream where;
+    where << current << " when front = " << ref_queue->front.load() << " and rear = " << ref_queue->rear.load();
+    throw IteratorPositionIllegal("MPMCQueue::Iterator::operator -> Iterator illegal: "+where.str());
+  }
+
+  return &ref_queue->cells[current & ref_queue->mask].value;
+}
+
+
+template<class T>
+bool MPMCQueue<T>::Iterator::is_stale() const {
+  return expected_mod_count != ref_queue->mod_count ||
+         expected_front     != ref_queue->front.load() ||
+         expected_rear      != ref_queue->rear.load();
+}
+
+}
+
+#endif /* MPMC_QUEUE_HPP_ */
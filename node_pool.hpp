@@ -0,0 +1,171 @@
+#ifndef NODE_POOL_HPP_
+#define NODE_POOL_HPP_
+
+#include <new>
+#include <utility>
+#include <type_traits>
+#include <algorithm>
+
+
+namespace ics {
+
+//A NodePool allocates nodes (e.g., the LNs in HashMap and HashSet) from slabs
+//  of raw storage it owns, and recycles released nodes through a free list;
+//  each data structure owns its own pool, so no pool is ever shared or copied.
+//Slabs double in size (up to MAX_SLAB nodes) as the pool grows; reserve can
+//  allocate one slab big enough for many nodes at once (e.g., all the
+//  sentinels needed by a newly doubled hash table). Slabs are returned to the
+//  heap only when the pool is destroyed; to shrink, a data structure remakes
+//  its live nodes in a new pool, releases the old ones, and swaps the pools.
+//Any class with the same make/release/reserve/swap interface can be used instead:
+//  NewDeletePool is the simplest one (each node is new'd and deleted).
+template<class N>
+class NodePool {
+  public:
+    NodePool() {}
+    NodePool(const NodePool<N>& to_copy) = delete;
+    NodePool<N>& operator = (const NodePool<N>& rhs) = delete;
+    ~NodePool();
+
+    template<class... Args>
+    N*   make    (Args&&... args);
+    void release (N* n);
+    void reserve (int n);
+    void swap    (NodePool<N>& other);
+    int  capacity() const;  //# nodes in all slabs (live or free)
+
+  private:
+    union Cell {
+      Cell* next_free;
+      typename std::aligned_storage<sizeof(N),alignof(N)>::type storage;
+    };
+    class Slab {
+      public:
+        Slab (int l, Slab* n) : cells(new Cell[l]), length(l), next(n) {}
+        ~Slab() {delete[] cells;}
+        Cell* cells;
+        int   length;
+        Slab* next;
+    };
+
+    static const int MIN_SLAB = 16;
+    static const int MAX_SLAB = 4096;
+    Slab* slabs        = nullptr; //All slabs, most recently allocated first
+    Cell* free_list    = nullptr; //Released cells, ready for reuse
+    int   free_count   = 0;       //# cells on free_list
+    int   unused       = 0;       //Cells at the end of slabs->cells never handed out
+    int   total_length = 0;
+    Cell* take_cell ();
+    void  add_slab  (int length);
+};
+
+
+//Used to select plain new/delete for the nodes of a data structure
+template<class N>
+class NewDeletePool {
+  public:
+    template<class... Args>
+    N*   make    (Args&&... args) {return new N(std::forward<Args>(args)...);}
+    void release (N* n)           {delete n;}
+    void reserve (int /*n*/)      {}
+    void swap    (NewDeletePool<N>& /*other*/) {}
+    int  capacity() const         {return 0;}
+};
+
+
+
+
+
+template<class N>
+NodePool<N>::~NodePool() {
+  for (Slab* s = slabs; s != nullptr; /*See body*/) {
+    Slab* to_delete = s;
+    s = s->next;
+    delete to_delete;
+  }
+}
+
+
+template<class N>
+template<class... Args>
+N* NodePool<N>::make(Args&&... args) {
+  Cell* c = take_cell();
+  try {
+    return new (&c->storage) N(std::forward<Args>(args)...);
+  } catch (...) {
+    c->next_free = free_list;
+    free_list = c;
+    ++free_count;
+    throw;
+  }
+}
+
+
+template<class N>
+void NodePool<N>::release(N* n) {
+  if (n == nullptr)
+    return;
+  n->~N();
+  Cell* c = reinterpret_cast<Cell*>(n);
+  c->next_free = free_list;
+  free_list = c;
+  ++free_count;
+}
+
+
+//Ensure at least n more nodes can be made without another heap allocation
+template<class N>
+void NodePool<N>::reserve(int n) {
+  if (n > free_count+unused)
+    add_slab(n-free_count-unused);
+}
+
+
+template<class N>
+void NodePool<N>::swap(NodePool<N>& other) {
+  std::swap(slabs,       other.slabs);
+  std::swap(free_list,   other.free_list);
+  std::swap(free_count,  other.free_count);
+  std::swap(unused,      other.unused);
+  std::swap(total_length,other.total_length);
+}
+
+
+template<class N>
+int NodePool<N>::capacity() const {
+  return total_length;
+}
+
+
+template<class N>
+typename NodePool<N>::Cell* NodePool<N>::take_cell() {
+  if (free_list != nullptr) {
+    Cell* answer = free_list;
+    free_list = free_list->next_free;
+    --free_count;
+    return answer;
+  }
+  if (unused == 0)
+    add_slab(std::min(int(MAX_SLAB),std::max(int(MIN_SLAB),total_length)));
+  return &slabs->cells[slabs->length - unused--];
+}
+
+
+//Cells never handed out from the current slab go on the free list, so
+//  adding a slab never wastes them
+template<class N>
+void NodePool<N>::add_slab(int length) {
+  for (/*See body*/; unused > 0; --unused) {
+    Cell* c = &slabs->cells[slabs->length - unused];
+    c->next_free = free_list;
+    free_list = c;
+    ++free_count;
+  }
+  slabs = new Slab(length,slabs);
+  unused = length;
+  total_length += length;
+}
+
+}
+
+#endif /* NODE_POOL_HPP_ */
@@ -1,35 +1,55 @@
-#ifndef PAIR_HPP_
-#define PAIR_HPP_
-
-
-#include <iostream>
-
-namespace ics {
-
-template<class F,class S>
-class pair {
-  public:
-    pair(){}
-    pair(const F& f,const S& s) : first(f), second(s) {/*first = f; second = s; std::cout << "in pair:" << first << "/" << second << std::endl;*/}
-    virtual ~pair(){}
-      F first;
-      S second;
-      bool operator == (const pair<F,S>& rhs) const {return first == rhs.first && second == rhs.second;}
-      bool operator != (const pair<F,S>& rhs) const {return !(*this==rhs);}
-
-      template<class F2,class S2>
-      friend std::ostream& operator << (std::ostream& outs, const pair<F2,S2>& p);
-};
-
-template<class F,class S>
-pair<F,S> make_pair(F f, S s){return pair<F,S>(f,s);}
-
-template<class F,class S>
-std::ostream& operator << (std::ostream& outs, const pair<F,S>& p){
-   outs << "pair[" << p.first << "," << p.second << "]";
-   return outs;
-}
-
-}
-
-#endif /* PAIR_HPP_ */
+#ifndef PAIR_HPP_
+#define PAIR_HPP_
+
+
+#include <iostream>
+#include <cstddef>
+#include <functional>
+#include <utility>
+
+namespace ics {
+
+//No virtual destructor (nothing derives from pair): a pair holds only first
+//  and second, and a pair of trivially copyable types is itself trivially
+//  copyable, so arrays of them (e.g., ArrayMap's Entries) copy with memcpy
+template<class F,class S>
+class pair {
+  public:
+    pair() = default;
+    pair(const F& f,const S& s) : first(f), second(s) {/*first = f; second = s; std::cout << "in pair:" << first << "/" << second << std::endl;*/}
+    template<class F2,class S2>
+    pair(F2&& f,S2&& s) : first(std::forward<F2>(f)), second(std::forward<S2>(s)) {}
+      F first;
+      S second;
+      bool operator == (const pair<F,S>& rhs) const {return first == rhs.first && second == rhs.second;}
+      bool operator != (const pair<F,S>& rhs) const {return !(*this==rhs);}
+
+      template<class F2,class S2>
+      friend std::ostream& operator << (std::ostream& outs, const pair<F2,S2>& p);
+};
+
+template<class F,class S>
+pair<F,S> make_pair(F f, S s){return pair<F,S>(std::move(f),std::move(s));}
+
+template<class F,class S>
+std::ostream& operator << (std::ostream& outs, const pair<F,S>& p){
+   outs << "pair[" << p.first << "," << p.second << "]";
+   return outs;
+}
+
+}
+
+
+//So ics::pair can be a key in HashMap/HashSet with the default HASH policy:
+//  combines the std::hash of first and second (as boost::hash_combine does)
+namespace std {
+template<class F,class S>
+struct hash<ics::pair<F,S>> {
+  std::size_t operator () (const ics::pair<F,S>& p) const {
+    std::size_t h = std::hash<F>()(p.first);
+    return h ^ (std::hash<S>()(p.second) + 0x9e3779b9 + (h << 6) + (h >> 2));
+  }
+};
+}
+
+#endif /* PAIR_HPP_ */
@@ -0,0 +1,623 @@
+#ifndef SEGMENTED_QUEUE_HPP_
+#define SEGMENTED_QUEUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "queue.hpp"
+
+
+namespace ics {
+
+//A queue stored in a linked list of fixed-length blocks (arrays of
+//  BLOCK_LENGTH values): enqueue fills the rear block, linking on a new one
+//  when it is full, and dequeue empties the front block, unlinking it when
+//  it is empty. So unlike ArrayQueue, growing never copies the values and
+//  enqueue/dequeue are O(1) in the worst case, not just amortized.
+//Unlinked blocks are kept (on a free list) and reused before any new block
+//  is allocated; shrink_to_fit deletes them.
+template<class T,int BLOCK_LENGTH = 256> class SegmentedQueue : public Queue<T>  {
+  static_assert(BLOCK_LENGTH >= 1, "SegmentedQueue: BLOCK_LENGTH must be >= 1");
+  private:
+    class Block;
+  public:
+    SegmentedQueue();
+    SegmentedQueue(const SegmentedQueue<T,BLOCK_LENGTH>& to_copy);
+    SegmentedQueue(SegmentedQueue<T,BLOCK_LENGTH>&& to_move);
+    SegmentedQueue(std::initializer_list<T> il);
+    SegmentedQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    virtual ~SegmentedQueue();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual T&   peek       () const;
+    virtual std::string str () const;
+
+    virtual int  enqueue (const T& element);
+    template<class... Args>
+    int          emplace (Args&&... args); //enqueue(T(args...)), moving the new value in
+    virtual T    dequeue ();
+    virtual void clear   ();
+
+    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> enqueue (const ITERATOR& start, const ITERATOR& stop);
+
+    void reserve       (int n); //Room for n values without allocating a block
+    void shrink_to_fit ();      //Delete the free blocks
+
+    virtual SegmentedQueue<T,BLOCK_LENGTH>& operator = (const SegmentedQueue<T,BLOCK_LENGTH>& rhs);
+    virtual SegmentedQueue<T,BLOCK_LENGTH>& operator = (SegmentedQueue<T,BLOCK_LENGTH>&& rhs);
+    virtual bool operator == (const Queue<T>& rhs) const;
+    virtual bool operator != (const Queue<T>& rhs) const;
+
+    template<class T2,int BLOCK_LENGTH2>
+    friend std::ostream& operator << (std::ostream& outs, const SegmentedQueue<T2,BLOCK_LENGTH2>& q);
+
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(SegmentedQueue<T,BLOCK_LENGTH>* iterate_over, Block* initial_block, int initial);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        Block*                          block;    //current is an index in block
+        int                             current;  //if can_erase is false, this value is unusable
+        SegmentedQueue<T,BLOCK_LENGTH>* ref_queue;
+        int                             expected_mod_count;
+        bool                            can_erase = true;
+    };
+
+    //For explicit use: Iterator<...>& it = c.ibegin(); ... or for (Iterator<...>& it = c.ibegin(); it != c.iend(); ++it)...
+    virtual ics::Iterator<T>& ibegin () const;
+    virtual ics::Iterator<T>& iend   () const;
+
+    //For implicit use: for (... i : c)...
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    class Block {
+      public:
+        T      values[BLOCK_LENGTH];
+        Block* next = nullptr;
+    };
+
+    //There is always at least one block: values are in front_block at
+    //  [front,...), the blocks after it, and rear_block at [...,rear).
+    //  rear may be 0 (in a block after front_block): the next enqueue goes there
+    Block* front_block;
+    Block* rear_block;
+    Block* free_blocks = nullptr;  //Unlinked blocks, reused by take_block
+    int    front       = 0;        //Index of front value in front_block
+    int    rear        = 0;        //Index one beyond rear value in rear_block
+    int    used        = 0;
+    int    free_count  = 0;        //# blocks on free_blocks
+    int    mod_count   = 0;        //For sensing concurrent modification
+    Block* take_block    ();
+    void   release_block (Block* b);
+    void   delete_blocks (Block* b);
+    void   make_room     ();       //Ensure rear < BLOCK_LENGTH
+    void   advance       (Block*& b, int& i) const;  //To the position after (b,i)
+    bool   is_end        (Block* b, int i) const {return b == rear_block && i == rear;}
+    int    erase_at      (Block* b, int i);
+  };
+
+
+
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::SegmentedQueue() {
+  front_block = rear_block = new Block;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::SegmentedQueue(const SegmentedQueue<T,BLOCK_LENGTH>& to_copy)
+  : SegmentedQueue<T,BLOCK_LENGTH>() {
+  reserve(to_copy.used);
+  for (const T& q_elem : to_copy)
+    enqueue(q_elem);
+}
+
+
+//to_move is left empty, with one (new) block
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::SegmentedQueue(SegmentedQueue<T,BLOCK_LENGTH>&& to_move)
+  : SegmentedQueue<T,BLOCK_LENGTH>() {
+  *this = std::move(to_move);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::SegmentedQueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop)
+  : SegmentedQueue<T,BLOCK_LENGTH>() {
+  enqueue(start,stop);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::SegmentedQueue(std::initializer_list<T> il)
+  : SegmentedQueue<T,BLOCK_LENGTH>() {
+  reserve(il.size());
+  for (const T& q_elem : il)
+    enqueue(q_elem);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::~SegmentedQueue() {
+  delete_blocks(front_block);
+  delete_blocks(free_blocks);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::empty() const {
+  return used == 0;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+inline int SegmentedQueue<T,BLOCK_LENGTH>::size() const {
+  return used;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+T& SegmentedQueue<T,BLOCK_LENGTH>::peek () const {
+  if (this->empty())
+    throw EmptyError("SegmentedQueue::peek");
+
+  return front_block->values[front];
+}
+
+
+//Blocks are separated by |
+template<class T,int BLOCK_LENGTH>
+std::string SegmentedQueue<T,BLOCK_LENGTH>::str() const {
+  std::ostringstream answer;
+  answer << "queue[";
+  int blocks = 1;
+  Block* b = front_block;
+  int    i = front;
+  while (!is_end(b,i)) {
+    answer << b->values[i];
+    Block* was = b;
+    advance(b,i);
+    if (b != was)
+      ++blocks;
+    if (!is_end(b,i))
+      answer << (b != was ? "|" : ",");
+  }
+  answer << "](block_length=" << BLOCK_LENGTH << ",blocks=" << blocks << ",free_blocks=" << free_count
+         << ",front=" << front << ",rear=" << rear << ",used=" << used << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+
+template<class T,int BLOCK_LENGTH>
+int SegmentedQueue<T,BLOCK_LENGTH>::enqueue(const T& element) {
+  make_room();
+  rear_block->values[rear++] = element;
+  ++used;
+  ++mod_count;
+  return 1;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+template<class... Args>
+int SegmentedQueue<T,BLOCK_LENGTH>::emplace(Args&&... args) {
+  make_room();
+  rear_block->values[rear++] = T(std::forward<Args>(args)...);
+  ++used;
+  ++mod_count;
+  return 1;
+}
+
+
+//An emptied front block is reused (if it is the only one) or freed
+template<class T,int BLOCK_LENGTH>
+T SegmentedQueue<T,BLOCK_LENGTH>::dequeue() {
+  if (this->empty())
+    throw EmptyError("SegmentedQueue::dequeue");
+
+  T answer = std::move(front_block->values[front++]);
+  --used;
+  if (front == BLOCK_LENGTH && front_block != rear_block) {
+    Block* to_release = front_block;
+    front_block = front_block->next;
+    front = 0;
+    release_block(to_release);
+  }
+  if (used == 0)
+    front = rear = 0;
+  ++mod_count;
+  return answer;
+}
+
+
+//All but one block go on the free list
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::clear() {
+  while (front_block != rear_block) {
+    Block* to_release = front_block;
+    front_block = front_block->next;
+    release_block(to_release);
+  }
+  front = rear = used = 0;
+  ++mod_count;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+int SegmentedQueue<T,BLOCK_LENGTH>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += enqueue(*start);
+
+  return count;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+template<class ITERATOR>
+auto SegmentedQueue<T,BLOCK_LENGTH>::enqueue (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i)
+    count += enqueue(*i);
+
+  return count;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>& SegmentedQueue<T,BLOCK_LENGTH>::operator = (const SegmentedQueue<T,BLOCK_LENGTH>& rhs) {
+  if (this == &rhs)
+    return *this;
+  clear();
+  reserve(rhs.used);
+  for (const T& q_elem : rhs)
+    enqueue(q_elem);
+  return *this;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>& SegmentedQueue<T,BLOCK_LENGTH>::operator = (SegmentedQueue<T,BLOCK_LENGTH>&& rhs) {
+  std::swap(front_block,rhs.front_block);  //rhs gets (and later deletes) the old blocks
+  std::swap(rear_block, rhs.rear_block);
+  std::swap(free_blocks,rhs.free_blocks);
+  std::swap(front,      rhs.front);
+  std::swap(rear,       rhs.rear);
+  std::swap(used,       rhs.used);
+  std::swap(free_count, rhs.free_count);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::operator == (const Queue<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+  // Uses ! and ==, so != on T need not be defined
+  const SegmentedQueue<T,BLOCK_LENGTH>* rhsSQ = dynamic_cast<const SegmentedQueue<T,BLOCK_LENGTH>*>(&rhs);
+  if (rhsSQ != nullptr) {
+    for (Iterator l = begin(), r = rhsSQ->begin(); l != end(); ++l, ++r)
+      if (!(*l == *r))
+        return false;
+    return true;
+  }
+
+  bool answer = true;
+  ics::Iterator<T>& rhs_i = rhs.ibegin();
+  for (Iterator l = begin(); answer && l != end(); ++l, ++rhs_i)
+    answer = *l == *rhs_i;
+  delete &rhs_i;  //ibegin returns a heap-allocated iterator
+  return answer;
+}
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::operator != (const Queue<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+std::ostream& operator << (std::ostream& outs, const SegmentedQueue<T,BLOCK_LENGTH>& q) {
+  outs << "queue[";
+
+  bool first = true;
+  for (const T& q_elem : q) {
+    outs << (first ? "" : ",") << q_elem;
+    first = false;
+  }
+
+  outs << "]:rear";
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T,int BLOCK_LENGTH>
+auto SegmentedQueue<T,BLOCK_LENGTH>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<SegmentedQueue<T,BLOCK_LENGTH>*>(this),front_block,front));
+}
+
+
+//KLUDGE: memory-leak
+template<class T,int BLOCK_LENGTH>
+auto SegmentedQueue<T,BLOCK_LENGTH>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<SegmentedQueue<T,BLOCK_LENGTH>*>(this),rear_block,rear));
+}
+
+
+template<class T,int BLOCK_LENGTH>
+auto SegmentedQueue<T,BLOCK_LENGTH>::begin () const -> SegmentedQueue<T,BLOCK_LENGTH>::Iterator {
+  return Iterator(const_cast<SegmentedQueue<T,BLOCK_LENGTH>*>(this),front_block,front);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+auto SegmentedQueue<T,BLOCK_LENGTH>::end () const -> SegmentedQueue<T,BLOCK_LENGTH>::Iterator {
+  return Iterator(const_cast<SegmentedQueue<T,BLOCK_LENGTH>*>(this),rear_block,rear);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+auto SegmentedQueue<T,BLOCK_LENGTH>::take_block() -> Block* {
+  if (free_blocks == nullptr)
+    return new Block;
+
+  Block* answer = free_blocks;
+  free_blocks = free_blocks->next;
+  answer->next = nullptr;
+  --free_count;
+  return answer;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::release_block(Block* b) {
+  b->next = free_blocks;
+  free_blocks = b;
+  ++free_count;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::delete_blocks(Block* b) {
+  while (b != nullptr) {
+    Block* to_delete = b;
+    b = b->next;
+    delete to_delete;
+  }
+}
+
+
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::make_room() {
+  if (rear < BLOCK_LENGTH)
+    return;
+  rear_block->next = take_block();
+  rear_block = rear_block->next;
+  rear = 0;
+}
+
+
+//Positions at the end of a block are the start of the next one, except at
+//  the end of the queue
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::advance(Block*& b, int& i) const {
+  if (++i == BLOCK_LENGTH && b != rear_block) {
+    b = b->next;
+    i = 0;
+  }
+}
+
+
+//Shift every value after (b,i) one position toward the front; if that
+//  empties rear_block (rear was 0), the block before it becomes rear_block
+template<class T,int BLOCK_LENGTH>
+int SegmentedQueue<T,BLOCK_LENGTH>::erase_at(Block* b, int i) {
+  for (;;) {
+    Block* next_b = b;
+    int    next_i = i;
+    advance(next_b,next_i);
+    if (is_end(next_b,next_i))
+      break;
+    b->values[i] = std::move(next_b->values[next_i]);
+    b = next_b;
+    i = next_i;
+  }
+
+  if (b != rear_block) {
+    release_block(rear_block);
+    b->next = nullptr;
+    rear_block = b;
+  }
+  rear = i;
+  --used;
+  ++mod_count;
+  return 1;
+}
+
+
+//Counts the room left in rear_block and in the free blocks
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::reserve(int n) {
+  for (int room = (BLOCK_LENGTH-rear) + free_count*BLOCK_LENGTH; room < n; room += BLOCK_LENGTH)
+    release_block(new Block);
+}
+
+
+template<class T,int BLOCK_LENGTH>
+void SegmentedQueue<T,BLOCK_LENGTH>::shrink_to_fit() {
+  delete_blocks(free_blocks);
+  free_blocks = nullptr;
+  free_count  = 0;
+}
+
+
+
+
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::Iterator::Iterator(SegmentedQueue<T,BLOCK_LENGTH>* iterate_over, Block* initial_block, int initial)
+  : block(initial_block), current(initial), ref_queue(iterate_over) {
+  expected_mod_count = ref_queue->mod_count;
+}
+
+template<class T,int BLOCK_LENGTH>
+SegmentedQueue<T,BLOCK_LENGTH>::Iterator::~Iterator() {}
+
+template<class T,int BLOCK_LENGTH>
+T SegmentedQueue<T,BLOCK_LENGTH>::Iterator::erase() {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("SegmentedQueue::Iterator::erase Iterator cursor already erased");
+  if (ref_queue->is_end(block,current))
+    throw CannotEraseError("SegmentedQueue::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  T to_return = block->values[current];
+  ref_queue->erase_at(block,current);
+  expected_mod_count = ref_queue->mod_count;
+  return to_return;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+std::string SegmentedQueue<T,BLOCK_LENGTH>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_queue->str() << "(current=" << current << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+
+template<class T,int BLOCK_LENGTH>
+const ics::Iterator<T>& SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator ++ () {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::operator ++");
+
+  if (ref_queue->is_end(block,current))
+    return *this;
+
+  if (!can_erase)
+    can_erase = true;
+  else
+    ref_queue->advance(block,current);
+
+  return *this;
+}
+
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T,int BLOCK_LENGTH>
+const ics::Iterator<T>& SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator ++ (int) {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::operator ++(int)");
+
+  if (ref_queue->is_end(block,current))
+    return *this;
+
+  Iterator* to_return = new Iterator(*this);
+  if (!can_erase)
+    can_erase = true;
+  else
+    ref_queue->advance(block,current);
+
+  return *to_return;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SegmentedQueue::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::operator ==");
+  if (ref_queue != rhs.ref_queue)
+    throw ComparingDifferentIteratorsError("SegmentedQueue::Iterator::operator ==");
+
+  return block == rhs.block && current == rhs.current;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SegmentedQueue::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+bool SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::operator !=");
+  if (ref_queue != rhs.ref_queue)
+    throw ComparingDifferentIteratorsError("SegmentedQueue::Iterator::operator !=");
+
+  return block != rhs.block || current != rhs.current;
+}
+
+
+template<class T,int BLOCK_LENGTH>
+T& SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator *() const {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::operator *");
+  if (!can_erase || ref_queue->is_end(block,current)) {
+    std::ostringstream where;
+    where << current << " when size = " << ref_queue->size();
+    throw IteratorPositionIllegal("SegmentedQueue::Iterator::operator * Iterator illegal: "+where.str());
+  }
+
+  return block->values[current];
+}
+
+
+template<class T,int BLOCK_LENGTH>
+T* SegmentedQueue<T,BLOCK_LENGTH>::Iterator::operator ->() const {
+  if (expected_mod_count != ref_queue->mod_count)
+    throw ConcurrentModificationError("SegmentedQueue::Iterator::operator ->");
+  if (!can_erase || ref_queue->is_end(block,current)) {
+    std::ostringstream where;
+    where << current << " when size = " << ref_queue->size();
+    throw IteratorPositionIllegal("SegmentedQueue::Iterator::operator -> Iterator illegal: "+where.str());
+  }
+
+  return &block->values[current];
+}
+
+}
+
+#endif /* SEGMENTED_QUEUE_HPP_ */
@@ -0,0 +1,290 @@
+#ifndef SNAPSHOT_HASH_MAP_HPP_
+#define SNAPSHOT_HASH_MAP_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "epoch_reclamation.hpp"
+#include "pair.hpp"
+#include "hash_map.hpp"
+
+
+namespace ics {
+
+//A map shared by any number of threads, for maps read far more often than
+//  written (e.g., configuration): readers never lock, wait, or write any
+//  shared memory. The map is an immutable HashMap (a "snapshot"); each
+//  write copies it, changes the copy, and then publishes the copy by
+//  atomically storing a pointer to it, so a reader sees either the whole
+//  old version or the whole new one. Replaced versions are deleted (see
+//  EpochDomain) once no reader can still be using them.
+//
+//Reads (empty/size/has_key/has_value/get/try_get/read/str/<<) are safe from
+//  any thread, each using one snapshot; use read to do more than one thing
+//  with the same snapshot (e.g., iterate over it). Writes (put/put_if_absent/
+//  erase/clear/update/compute/write) are safe from any thread too, but are
+//  serialized by a mutex and each copies the whole map: use write to make
+//  many changes with one copy.
+//It is not an ics::Map: operator [] and the iterators would return
+//  references into a snapshot, which may be deleted after the call returns.
+template<class KEY,class T,class HASH = std::hash<KEY>,class EQUALS = std::equal_to<KEY>>
+class SnapshotHashMap {
+  public:
+    typedef ics::pair<KEY,T> Entry;
+    typedef HashMap<KEY,T,HASH,EQUALS> Snapshot;
+    explicit SnapshotHashMap(const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());
+    explicit SnapshotHashMap(const Snapshot& initial);
+    SnapshotHashMap(std::initializer_list<Entry> il, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());
+    SnapshotHashMap(const SnapshotHashMap<KEY,T,HASH,EQUALS>& to_copy) = delete;
+    SnapshotHashMap<KEY,T,HASH,EQUALS>& operator = (const SnapshotHashMap<KEY,T,HASH,EQUALS>& rhs) = delete;
+    ~SnapshotHashMap();  //No thread may be using the map
+
+    bool empty      () const;
+    int  size       () const;
+    bool has_key    (const KEY& key) const;
+    bool has_value  (const T& value) const;
+    std::string str () const;
+
+    T    get     (const KEY& key) const;            //A copy of key's value; throws KeyError if absent
+    bool try_get (const KEY& key, T& into) const;   //false (and into unchanged) if absent
+
+    //f(const Snapshot&) (whose result read returns) may use the snapshot
+    //  only until it returns
+    template<class F>
+    auto read (F f) const -> decltype(f(std::declval<const Snapshot&>()));
+
+    T    put           (const KEY& key, const T& value);  //As HashMap::put
+    bool put_if_absent (const KEY& key, const T& value);  //Whether it put (copying only then)
+    T    erase         (const KEY& key);                  //Throws KeyError if absent
+    void clear         ();
+
+    //As ConcurrentHashMap: f(T& value) updates key's value; update calls it
+    //  only if key is present (and copies only then)
+    template<class F>
+    bool update  (const KEY& key, F f);
+    template<class F>
+    T    compute (const KEY& key, F f);
+
+    //f(Snapshot&) changes a copy of the current snapshot, which is then
+    //  published; if f throws, nothing is published
+    template<class F>
+    void write (F f);
+
+    template<class KEY2,class T2,class HASH2,class EQUALS2>
+    friend std::ostream& operator << (std::ostream& outs, const SnapshotHashMap<KEY2,T2,HASH2,EQUALS2>& m);
+
+  private:
+    std::atomic<const Snapshot*> current;
+    std::mutex                   write_lock;  //Writers copy/publish one at a time
+  };
+
+
+
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+SnapshotHashMap<KEY,T,HASH,EQUALS>::SnapshotHashMap(const HASH& ahash, const EQUALS& aequals)
+  : current(new Snapshot(ahash,aequals))
+{}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+SnapshotHashMap<KEY,T,HASH,EQUALS>::SnapshotHashMap(const Snapshot& initial)
+  : current(nullptr) {
+  Snapshot* first_snapshot = new Snapshot(initial);
+  first_snapshot->incremental_rehash(0);  //See write
+  current.store(first_snapshot,std::memory_order_relaxed);
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+SnapshotHashMap<KEY,T,HASH,EQUALS>::SnapshotHashMap(std::initializer_list<Entry> il, const HASH& ahash, const EQUALS& aequals)
+  : current(new Snapshot(il,ahash,aequals))
+{}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+SnapshotHashMap<KEY,T,HASH,EQUALS>::~SnapshotHashMap() {
+  delete current.load();
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool SnapshotHashMap<KEY,T,HASH,EQUALS>::empty() const {
+  return read([] (const Snapshot& m) {return m.empty();});
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+int SnapshotHashMap<KEY,T,HASH,EQUALS>::size() const {
+  return read([] (const Snapshot& m) {return m.size();});
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool SnapshotHashMap<KEY,T,HASH,EQUALS>::has_key (const KEY& key) const {
+  return read([&key] (const Snapshot& m) {return m.has_key(key);});
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool SnapshotHashMap<KEY,T,HASH,EQUALS>::has_value (const T& value) const {
+  return read([&value] (const Snapshot& m) {return m.has_value(value);});
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::string SnapshotHashMap<KEY,T,HASH,EQUALS>::str() const {
+  std::ostringstream answer;
+  read([&answer] (const Snapshot& m) {answer << "SnapshotHashMap[" << m.str() << "]";});
+  return answer.str();
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+T SnapshotHashMap<KEY,T,HASH,EQUALS>::get (const KEY& key) const {
+  T answer;
+  if (!try_get(key,answer)) {
+    std::ostringstream where;
+    where << "SnapshotHashMap::get: key(" << key << ") not in Map";
+    throw KeyError(where.str());
+  }
+  return answer;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+bool SnapshotHashMap<KEY,T,HASH,EQUALS>::try_get (const KEY& key, T& into) const {
+  return read([&key,&into] (const Snapshot& m) -> bool {
+    if (!m.has_key(key))
+      return false;
+    into = m[key];
+    return true;
+  });
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class F>
+auto SnapshotHashMap<KEY,T,HASH,EQUALS>::read (F f) const -> decltype(f(std::declval<const Snapshot&>())) {
+  EpochGuard guard;
+  return f(*current.load(std::memory_order_acquire));
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+T SnapshotHashMap<KEY,T,HASH,EQUALS>::put(const KEY& key, const T& value) {
+  T to_return;
+  write([&] (Snapshot& m) {to_return = m.put(key,value);});
+  return to_return;
+}
+
+
+//Writers are serialized, so the current snapshot can be checked (without a
+//  guard: it can't be retired meanwhile) before copying it
+template<class KEY,class T,class HASH,class EQUALS>
+bool SnapshotHashMap<KEY,T,HASH,EQUALS>::put_if_absent (const KEY& key, const T& value) {
+  {
+    std::lock_guard<std::mutex> guard(write_lock);
+    if (current.load(std::memory_order_relaxed)->has_key(key))
+      return false;
+  }
+  bool put = false;
+  write([&] (Snapshot& m) {
+    if (!m.has_key(key)) {
+      m.put(key,value);
+      put = true;
+    }
+  });
+  return put;
+}
+
+
+//As put_if_absent: an absent key is found (and KeyError thrown) without copying
+template<class KEY,class T,class HASH,class EQUALS>
+T SnapshotHashMap<KEY,T,HASH,EQUALS>::erase(const KEY& key) {
+  {
+    std::lock_guard<std::mutex> guard(write_lock);
+    if (!current.load(std::memory_order_relaxed)->has_key(key)) {
+      std::ostringstream answer;
+      answer << "SnapshotHashMap::erase: key(" << key << ") not in Map";
+      throw KeyError(answer.str());
+    }
+  }
+  T to_return;
+  write([&] (Snapshot& m) {to_return = m.erase(key);});
+  return to_return;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+void SnapshotHashMap<KEY,T,HASH,EQUALS>::clear() {
+  write([] (Snapshot& m) {m.clear();});
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class F>
+bool SnapshotHashMap<KEY,T,HASH,EQUALS>::update (const KEY& key, F f) {
+  if (!has_key(key))
+    return false;
+  bool updated = false;
+  write([&] (Snapshot& m) {
+    if (m.has_key(key)) {
+      f(m[key]);
+      updated = true;
+    }
+  });
+  return updated;
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+template<class F>
+T SnapshotHashMap<KEY,T,HASH,EQUALS>::compute (const KEY& key, F f) {
+  T to_return;
+  write([&] (Snapshot& m) {
+    T& value = m[key];
+    f(value);
+    to_return = value;
+  });
+  return to_return;
+}
+
+
+//The new snapshot is stored (release) before the old one is retired, so
+//  readers entering after the retire see the new one. Any rehash is finished
+//  first: a published snapshot never changes, and each write copies it whole
+template<class KEY,class T,class HASH,class EQUALS>
+template<class F>
+void SnapshotHashMap<KEY,T,HASH,EQUALS>::write (F f) {
+  std::lock_guard<std::mutex> guard(write_lock);
+  const Snapshot* old_snapshot = current.load(std::memory_order_relaxed);
+  Snapshot* new_snapshot = new Snapshot(*old_snapshot);
+  try {
+    f(*new_snapshot);
+  } catch (...) {
+    delete new_snapshot;
+    throw;
+  }
+  new_snapshot->incremental_rehash(0);
+  current.store(new_snapshot,std::memory_order_release);
+  EpochDomain::global().retire(const_cast<Snapshot*>(old_snapshot));
+}
+
+
+template<class KEY,class T,class HASH,class EQUALS>
+std::ostream& operator << (std::ostream& outs, const SnapshotHashMap<KEY,T,HASH,EQUALS>& m) {
+  m.read([&outs] (const typename SnapshotHashMap<KEY,T,HASH,EQUALS>::Snapshot& s) {outs << s;});
+  return outs;
+}
+
+}
+
+#endif /* SNAPSHOT_HASH_MAP_HPP_ */
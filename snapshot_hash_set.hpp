@@ -0,0 +1,187 @@
+#ifndef SNAPSHOT_HASH_SET_HPP_
+#define SNAPSHOT_HASH_SET_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <functional>
+#include <atomic>
+#include <mutex>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "epoch_reclamation.hpp"
+#include "hash_set.hpp"
+
+
+namespace ics {
+
+//A set shared by any number of threads, for sets read far more often than
+//  written: see SnapshotHashMap, whose snapshots/reads/writes this mirrors.
+//Reads (empty/size/contains/read/str/<<) never lock, wait, or write any
+//  shared memory; writes (insert/erase/clear/write) are serialized, and each
+//  copies the whole set (use write to make many changes with one copy).
+//It is not an ics::Set: the iterators would refer into a snapshot, which may
+//  be deleted after the call returns.
+template<class T,class HASH = std::hash<T>,class EQUALS = std::equal_to<T>>
+class SnapshotHashSet {
+  public:
+    typedef HashSet<T,HASH,EQUALS> Snapshot;
+    explicit SnapshotHashSet(const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());
+    explicit SnapshotHashSet(const Snapshot& initial);
+    SnapshotHashSet(std::initializer_list<T> il, const HASH& ahash = HASH(), const EQUALS& aequals = EQUALS());
+    SnapshotHashSet(const SnapshotHashSet<T,HASH,EQUALS>& to_copy) = delete;
+    SnapshotHashSet<T,HASH,EQUALS>& operator = (const SnapshotHashSet<T,HASH,EQUALS>& rhs) = delete;
+    ~SnapshotHashSet();  //No thread may be using the set
+
+    bool empty      () const;
+    int  size       () const;
+    bool contains   (const T& element) const;
+    std::string str () const;
+
+    //f(const Snapshot&) (whose result read returns) may use the snapshot
+    //  only until it returns
+    template<class F>
+    auto read (F f) const -> decltype(f(std::declval<const Snapshot&>()));
+
+    int  insert (const T& element);  //As HashSet: # inserted (copying only if 1)
+    int  erase  (const T& element);  //As HashSet: # erased (copying only if 1)
+    void clear  ();
+
+    //f(Snapshot&) changes a copy of the current snapshot, which is then
+    //  published; if f throws, nothing is published
+    template<class F>
+    void write (F f);
+
+    template<class T2,class HASH2,class EQUALS2>
+    friend std::ostream& operator << (std::ostream& outs, const SnapshotHashSet<T2,HASH2,EQUALS2>& s);
+
+  private:
+    std::atomic<const Snapshot*> current;
+    std::mutex                   write_lock;  //Writers copy/publish one at a time
+  };
+
+
+
+
+
+template<class T,class HASH,class EQUALS>
+SnapshotHashSet<T,HASH,EQUALS>::SnapshotHashSet(const HASH& ahash, const EQUALS& aequals)
+  : current(new Snapshot(ahash,aequals))
+{}
+
+
+template<class T,class HASH,class EQUALS>
+SnapshotHashSet<T,HASH,EQUALS>::SnapshotHashSet(const Snapshot& initial)
+  : current(new Snapshot(initial))
+{}
+
+
+template<class T,class HASH,class EQUALS>
+SnapshotHashSet<T,HASH,EQUALS>::SnapshotHashSet(std::initializer_list<T> il, const HASH& ahash, const EQUALS& aequals)
+  : current(new Snapshot(il,ahash,aequals))
+{}
+
+
+template<class T,class HASH,class EQUALS>
+SnapshotHashSet<T,HASH,EQUALS>::~SnapshotHashSet() {
+  delete current.load();
+}
+
+
+template<class T,class HASH,class EQUALS>
+bool SnapshotHashSet<T,HASH,EQUALS>::empty() const {
+  return read([] (const Snapshot& s) {return s.empty();});
+}
+
+
+template<class T,class HASH,class EQUALS>
+int SnapshotHashSet<T,HASH,EQUALS>::size() const {
+  return read([] (const Snapshot& s) {return s.size();});
+}
+
+
+template<class T,class HASH,class EQUALS>
+bool SnapshotHashSet<T,HASH,EQUALS>::contains (const T& element) const {
+  return read([&element] (const Snapshot& s) {return s.contains(element);});
+}
+
+
+template<class T,class HASH,class EQUALS>
+std::string SnapshotHashSet<T,HASH,EQUALS>::str() const {
+  std::ostringstream answer;
+  read([&answer] (const Snapshot& s) {answer << "SnapshotHashSet[" << s.str() << "]";});
+  return answer.str();
+}
+
+
+template<class T,class HASH,class EQUALS>
+template<class F>
+auto SnapshotHashSet<T,HASH,EQUALS>::read (F f) const -> decltype(f(std::declval<const Snapshot&>())) {
+  EpochGuard guard;
+  return f(*current.load(std::memory_order_acquire));
+}
+
+
+//Writers are serialized, so the current snapshot can be checked (without a
+//  guard: it can't be retired meanwhile) before copying it
+template<class T,class HASH,class EQUALS>
+int SnapshotHashSet<T,HASH,EQUALS>::insert(const T& element) {
+  {
+    std::lock_guard<std::mutex> guard(write_lock);
+    if (current.load(std::memory_order_relaxed)->contains(element))
+      return 0;
+  }
+  int count = 0;
+  write([&] (Snapshot& s) {count = s.insert(element);});
+  return count;
+}
+
+
+template<class T,class HASH,class EQUALS>
+int SnapshotHashSet<T,HASH,EQUALS>::erase(const T& element) {
+  {
+    std::lock_guard<std::mutex> guard(write_lock);
+    if (!current.load(std::memory_order_relaxed)->contains(element))
+      return 0;
+  }
+  int count = 0;
+  write([&] (Snapshot& s) {count = s.erase(element);});
+  return count;
+}
+
+
+template<class T,class HASH,class EQUALS>
+void SnapshotHashSet<T,HASH,EQUALS>::clear() {
+  write([] (Snapshot& s) {s.clear();});
+}
+
+
+//The new snapshot is stored (release) before the old one is retired, so
+//  readers entering after the retire see the new one
+template<class T,class HASH,class EQUALS>
+template<class F>
+void SnapshotHashSet<T,HASH,EQUALS>::write (F f) {
+  std::lock_guard<std::mutex> guard(write_lock);
+  const Snapshot* old_snapshot = current.load(std::memory_order_relaxed);
+  Snapshot* new_snapshot = new Snapshot(*old_snapshot);
+  try {
+    f(*new_snapshot);
+  } catch (...) {
+    delete new_snapshot;
+    throw;
+  }
+  current.store(new_snapshot,std::memory_order_release);
+  EpochDomain::global().retire(const_cast<Snapshot*>(old_snapshot));
+}
+
+
+template<class T,class HASH,class EQUALS>
+std::ostream& operator << (std::ostream& outs, const SnapshotHashSet<T,HASH,EQUALS>& s) {
+  s.read([&outs] (const typename SnapshotHashSet<T,HASH,EQUALS>::Snapshot& snapshot) {outs << snapshot;});
+  return outs;
+}
+
+}
+
+#endif /* SNAPSHOT_HASH_SET_HPP_ */
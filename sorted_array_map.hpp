@@ -0,0 +1,701 @@
+#ifndef SORTED_ARRAY_MAP_HPP_
+#define SORTED_ARRAY_MAP_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "pair.hpp"
+#include "map.hpp"
+#include "array_copy.hpp"
+
+
+namespace ics {
+
+//An ArrayMap whose entries are kept in increasing order of their keys (by
+//  LT), so has_key, put, erase, and [] find a key by binary search: O(log N).
+//  Adding or erasing a key shifts the entries after it: O(N), but moving
+//  contiguous entries, not comparing keys.
+//Two keys a and b are the same iff !LT()(a,b) && !LT()(b,a).
+//put of a range of M entries is a merge: O(N+M) after sorting the range
+//  (skipped if it is already sorted, e.g., from another SortedArrayMap);
+//  == against another SortedArrayMap is O(N).
+template<class KEY,class T,class LT = std::less<KEY>> class SortedArrayMap : public Map<KEY,T>	{
+  public:
+    typedef ics::pair<KEY,T> Entry;
+	  SortedArrayMap();
+	  explicit SortedArrayMap(int initialLength);
+	  SortedArrayMap(const SortedArrayMap<KEY,T,LT>& to_copy);
+	  SortedArrayMap(SortedArrayMap<KEY,T,LT>&& to_move);
+	  SortedArrayMap(std::initializer_list<Entry> il);
+    SortedArrayMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop);
+	  virtual ~SortedArrayMap();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual bool has_key    (const KEY& key) const;
+    virtual bool has_value  (const T& value) const;
+    virtual std::string str () const;
+
+    virtual T    put   (const KEY& key, const T& value);
+    template<class... Args>
+    T&           emplace (const KEY& key, Args&&... args); //put(key,T(args...)), moving the new value in
+    virtual T    erase (const KEY& key);
+    virtual void clear ();
+
+    virtual int put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,Entry> put (const ITERATOR& start, const ITERATOR& stop);
+
+    void reserve       (int n); //Room for n values without reallocating
+    void shrink_to_fit ();      //Release the unused part of the array
+
+    virtual T&       operator [] (const KEY&);
+    virtual const T& operator [] (const KEY&) const;
+    virtual SortedArrayMap<KEY,T,LT>& operator = (const SortedArrayMap<KEY,T,LT>& rhs);
+    virtual SortedArrayMap<KEY,T,LT>& operator = (SortedArrayMap<KEY,T,LT>&& rhs);
+    virtual bool operator == (const Map<KEY,T>& rhs) const;
+    virtual bool operator != (const Map<KEY,T>& rhs) const;
+
+    template<class KEY2,class T2,class LT2>
+    friend std::ostream& operator << (std::ostream& outs, const SortedArrayMap<KEY2,T2,LT2>& m);
+
+    //Iterators visit entries in increasing order of their keys
+    class Iterator final : public ics::Iterator<Entry> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(SortedArrayMap<KEY,T,LT>* iterate_over, int initial);
+        virtual ~Iterator() {}
+        virtual Entry       erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<Entry>& operator ++ ();
+        virtual const ics::Iterator<Entry>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<Entry>& rhs) const;
+        virtual bool operator != (const ics::Iterator<Entry>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual Entry& operator *  () const;
+        virtual Entry* operator -> () const;
+      private:
+        int                       current;  //if can_erase is false, this value is unusable
+        SortedArrayMap<KEY,T,LT>* ref_map;
+        int                       expected_mod_count;
+        bool                      can_erase = true;
+    };
+
+    //For explicit use: Iterator<...>& it = c.ibegin(); ... or for (Iterator<...>& it = c.ibegin(); it != c.iend(); ++it)...
+    virtual ics::Iterator<Entry>& ibegin () const;
+    virtual ics::Iterator<Entry>& iend   () const;
+
+    //For implicit use: for (... i : c)...
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+    //KLUDGE: could define
+    //virtual ics::Iterator<KEY>&  begin_key   () const;
+    //virtual ics::Iterator<KEY>&  end_key     () const;
+    //virtual ics::Iterator<T>&    begin_value () const;
+    //virtual ics::Iterator<T>&    end_value   () const;
+
+    private:
+      Entry* map;
+      int length    = 0; //Physical length of array
+      int used      = 0; //Amount of array used
+      int mod_count = 0; //For sensing concurrent modification
+      LT  lt;
+      bool   same          (const KEY& a, const KEY& b) const {return !lt(a,b) && !lt(b,a);}
+      int    lower_bound   (const KEY& key) const; //Index of the first entry whose key is not less than key
+      bool   found_at      (int i, const KEY& key) const;
+      int    index_of      (const KEY& key) const;
+      T      change_at     (int i, const T& value);
+      void   insert_at     (int i, Entry entry);
+      T      erase_at      (int i);
+      Entry* sorted_entries(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, int& n) const;
+      void   merge_put     (Entry* entries, int n);
+      void   ensure_length (int new_length);
+      void   reallocate    (int new_length);
+  };
+
+
+
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::SortedArrayMap() {
+  map = new Entry[length];
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::SortedArrayMap(int initial_length) : length(initial_length) {
+  if (length < 0)
+    length = 0;
+  map = new Entry[length];
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::SortedArrayMap(const SortedArrayMap<KEY,T,LT>& to_copy) : length(to_copy.length), used(to_copy.used) {
+  map = new Entry[length];
+  ics::copy_array(map,to_copy.map,used);
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::SortedArrayMap(SortedArrayMap<KEY,T,LT>&& to_move)
+  : map(to_move.map), length(to_move.length), used(to_move.used) {
+  to_move.map = nullptr;   //to_move is left empty, with length 0
+  to_move.length = 0;
+  to_move.used = 0;
+  ++to_move.mod_count;
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::SortedArrayMap(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop) {
+  map = new Entry[length];
+  put(start,stop);
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::SortedArrayMap(std::initializer_list<Entry> il) {
+  map = new Entry[length];
+  for (const Entry& m_entry : il)
+    put(m_entry.first,m_entry.second);
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::~SortedArrayMap() {
+  delete[] map;
+}
+
+
+
+template<class KEY,class T,class LT>
+inline bool SortedArrayMap<KEY,T,LT>::empty() const {
+  return used == 0;
+}
+
+
+template<class KEY,class T,class LT>
+int SortedArrayMap<KEY,T,LT>::size() const {
+  return used;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::has_key (const KEY& element) const {
+  return found_at(lower_bound(element),element);
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::has_value (const T& element) const {
+  for (int i=0; i<used; ++i)
+    if (map[i].second == element)
+      return true;
+
+  return false;
+}
+
+
+template<class KEY,class T,class LT>
+std::string SortedArrayMap<KEY,T,LT>::str() const {
+  std::ostringstream answer;
+  answer << *this << "(length=" << length << ",used=" << used << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+
+template<class KEY,class T,class LT>
+T SortedArrayMap<KEY,T,LT>::put(const KEY& key, const T& value) {
+  int i = lower_bound(key);
+  if (found_at(i,key))
+    return change_at(i,value);
+
+  insert_at(i,Entry(key,value));
+  return map[i].second;
+}
+
+
+template<class KEY,class T,class LT>
+template<class... Args>
+T& SortedArrayMap<KEY,T,LT>::emplace(const KEY& key, Args&&... args) {
+  int i = lower_bound(key);
+  if (found_at(i,key)) {
+    map[i].second = T(std::forward<Args>(args)...);
+    ++mod_count;
+  }else
+    insert_at(i,Entry(key,T(std::forward<Args>(args)...)));
+  return map[i].second;
+}
+
+
+template<class KEY,class T,class LT>
+T SortedArrayMap<KEY,T,LT>::erase(const KEY& key) {
+  int i = index_of(key);
+  if (i != -1)
+    return erase_at(i);
+
+  std::ostringstream answer;
+  answer << "SortedArrayMap::erase: key(" << key << ") not in Map";
+  throw KeyError(answer.str());
+}
+
+
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::clear() {
+  used = 0;
+  ++mod_count;
+}
+
+
+template<class KEY,class T,class LT>
+int SortedArrayMap<KEY,T,LT>::put (ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop) {
+  int count;
+  Entry* entries = sorted_entries(start,stop,count);
+  merge_put(entries,count);
+  delete[] entries;
+  return count;
+}
+
+
+template<class KEY,class T,class LT>
+template<class ITERATOR>
+auto SortedArrayMap<KEY,T,LT>::put (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,Entry> {
+  ITERATOR i = start;
+  ics::Iterator<Entry>& from = i;  //so the virtual put is called, not this one
+  return put(from,stop);
+}
+
+
+template<class KEY,class T,class LT>
+T& SortedArrayMap<KEY,T,LT>::operator [] (const KEY& key) {
+  int i = lower_bound(key);
+  if (found_at(i,key))
+    return map[i].second;
+
+  insert_at(i,Entry(key,T()));
+  return map[i].second;
+}
+
+
+template<class KEY,class T,class LT>
+const T& SortedArrayMap<KEY,T,LT>::operator [] (const KEY& key) const {
+  int i = index_of(key);
+  if (i != -1)
+    return map[i].second;
+
+  std::ostringstream answer;
+  answer << "SortedArrayMap::operator []: key(" << key << ") not in Map";
+  throw KeyError(answer.str());
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>& SortedArrayMap<KEY,T,LT>::operator = (const SortedArrayMap<KEY,T,LT>& rhs) {
+  if (this == &rhs)
+    return *this;
+  this->ensure_length(rhs.used);
+  used = rhs.used;
+  ics::copy_array(map,rhs.map,used);
+  ++mod_count;
+  return *this;
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>& SortedArrayMap<KEY,T,LT>::operator = (SortedArrayMap<KEY,T,LT>&& rhs) {
+  std::swap(map,   rhs.map);  //rhs gets (and later deletes) the old array
+  std::swap(length,rhs.length);
+  std::swap(used,  rhs.used);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::operator == (const Map<KEY,T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+  const SortedArrayMap<KEY,T,LT>* rhsSAM = dynamic_cast<const SortedArrayMap<KEY,T,LT>*>(&rhs);
+  if (rhsSAM != nullptr) {
+    for (int i=0; i<used; ++i)
+      if (!same(map[i].first,rhsSAM->map[i].first) || !(map[i].second == rhsSAM->map[i].second))
+        return false;
+    return true;
+  }
+
+  for (int i=0; i<used; ++i)
+    // Uses ! and ==, so != on T need not be defined
+    if (!rhs.has_key(map[i].first) || !(map[i].second == rhs[map[i].first]))
+      return false;
+
+  return true;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::operator != (const Map<KEY,T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+
+template<class KEY,class T,class LT>
+std::ostream& operator << (std::ostream& outs, const SortedArrayMap<KEY,T,LT>& m) {
+  outs << "map[";
+
+  if (!m.empty()) {
+    //m.map[i] couts as map[pair[key,value]]
+    outs << m.map[0].first << "->" << m.map[0].second;
+    for (int i = 1; i < m.used; ++i) {
+      outs << "," << m.map[i].first << "->" << m.map[i].second;
+    }
+  }
+
+  outs << "]";
+  return outs;
+}
+
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::ibegin () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<SortedArrayMap<KEY,T,LT>*>(this),0));
+}
+
+//KLUDGE: memory-leak
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::iend () const -> ics::Iterator<Entry>& {
+  return *(new Iterator(const_cast<SortedArrayMap<KEY,T,LT>*>(this),used));
+}
+
+
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::begin () const -> SortedArrayMap<KEY,T,LT>::Iterator {
+   return Iterator(const_cast<SortedArrayMap<KEY,T,LT>*>(this),0);
+}
+
+
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::end () const -> SortedArrayMap<KEY,T,LT>::Iterator {
+  return Iterator(const_cast<SortedArrayMap<KEY,T,LT>*>(this),used);
+}
+
+
+template<class KEY,class T,class LT>
+int SortedArrayMap<KEY,T,LT>::lower_bound(const KEY& key) const {
+  int low = 0, high = used;
+  while (low < high) {
+    int mid = low + (high-low)/2;
+    if (lt(map[mid].first,key))
+      low = mid+1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+
+//i is lower_bound(key): map[i].first is not less than key, so it is the
+//  same as key iff key is not less than it
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::found_at(int i, const KEY& key) const {
+  return i < used && !lt(key,map[i].first);
+}
+
+
+template<class KEY,class T,class LT>
+int SortedArrayMap<KEY,T,LT>::index_of(const KEY& key) const {
+  int i = lower_bound(key);
+  return found_at(i,key) ? i : -1;
+}
+
+
+template<class KEY,class T,class LT>
+T SortedArrayMap<KEY,T,LT>::change_at(int i, const T& value) {
+  T old_value = map[i].second;
+  map[i].second = value;
+  ++mod_count;
+  return old_value;
+}
+
+
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::insert_at(int i, Entry entry) {
+  this->ensure_length(used+1);
+  for (int j=used; j>i; --j)
+    map[j] = std::move(map[j-1]);
+  map[i] = std::move(entry);
+  ++used;
+  ++mod_count;
+}
+
+
+template<class KEY,class T,class LT>
+T SortedArrayMap<KEY,T,LT>::erase_at(int i) {
+  T erased = std::move(map[i].second);
+  for (--used; i<used; ++i)
+    map[i] = std::move(map[i+1]);
+  ++mod_count;
+  return erased;
+}
+
+
+//Returns a new[]'d array of the n entries in [start,stop), stably sorted by
+//  key (so entries with the same key stay in the order they were put);
+//  sorting is skipped if the range is already in order
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::sorted_entries(ics::Iterator<Entry>& start, const ics::Iterator<Entry>& stop, int& n) const -> Entry* {
+  int entries_length = 8;
+  Entry* entries = new Entry[entries_length];
+  n = 0;
+  for (; start != stop; ++start) {
+    if (n == entries_length) {
+      Entry* old_entries = entries;
+      entries = new Entry[2*entries_length];
+      for (int i=0; i<n; ++i)
+        entries[i] = std::move(old_entries[i]);
+      entries_length *= 2;
+      delete[] old_entries;
+    }
+    entries[n++] = *start;
+  }
+
+  auto key_lt = [this](const Entry& a, const Entry& b){return lt(a.first,b.first);};
+  if (!std::is_sorted(entries,entries+n,key_lt))
+    std::stable_sort(entries,entries+n,key_lt);
+  return entries;
+}
+
+
+//Only the last of the entries with the same key is put (as if each were put
+//  in turn); then merge from the back, so each entry moves once. Keys already
+//  in the map get their new values and leave a gap at the front, closed by
+//  one more pass
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::merge_put(Entry* entries, int n) {
+  if (n == 0)
+    return;
+
+  int unique = 0;
+  for (int r=0; r<n; ++r)
+    if (unique > 0 && same(entries[unique-1].first,entries[r].first))
+      entries[unique-1] = std::move(entries[r]);
+    else if (unique++ != r)
+      entries[unique-1] = std::move(entries[r]);
+  n = unique;
+
+  this->ensure_length(used+n);
+  int i = used-1, j = n-1, k = used+n-1;
+  int added = n;
+  while (j >= 0) {
+    if (i >= 0 && lt(entries[j].first,map[i].first))
+      map[k--] = std::move(map[i--]);
+    else if (i >= 0 && !lt(map[i].first,entries[j].first)) {
+      map[i].second = std::move(entries[j--].second);
+      map[k--] = std::move(map[i--]);
+      --added;
+    }else
+      map[k--] = std::move(entries[j--]);
+  }
+
+  int gap = k-i;
+  if (gap > 0)
+    for (int m=k+1; m<used+n; ++m)
+      map[m-gap] = std::move(map[m]);
+
+  used += added;
+  ++mod_count;
+}
+
+
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::ensure_length(int new_length) {
+  if (length >= new_length)
+    return;
+  reallocate(std::max(new_length,2*length));
+}
+
+
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::reallocate(int new_length) {
+  Entry*  old_map  = map;
+  length = new_length;
+  map = new Entry[length];
+  ics::move_array(map,old_map,used);
+
+  delete [] old_map;
+}
+
+
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::reserve(int n) {
+  if (length < n)
+    reallocate(n);
+}
+
+
+template<class KEY,class T,class LT>
+void SortedArrayMap<KEY,T,LT>::shrink_to_fit() {
+  if (length > used)
+    reallocate(used);
+}
+
+
+template<class KEY,class T,class LT>
+SortedArrayMap<KEY,T,LT>::Iterator::Iterator(SortedArrayMap<KEY,T,LT>* iterate_over, int initial) : current(initial), ref_map(iterate_over) {
+  expected_mod_count = ref_map->mod_count;
+}
+
+
+//KLUDGE: must define in .hpp
+//template<class KEY,class T,class LT>
+//SortedArrayMap<KEY,T,LT>::Iterator::~Iterator() {}
+
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::Iterator::erase() -> Entry {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("SortedArrayMap::Iterator::erase Iterator cursor already erased");
+  if (current < 0 || current >= ref_map->used)
+    throw CannotEraseError("SortedArrayMap::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  Entry to_return = ref_map->map[current];
+  ref_map->erase_at(current);
+  expected_mod_count = ref_map->mod_count;
+  return to_return;
+}
+
+
+template<class KEY,class T,class LT>
+std::string SortedArrayMap<KEY,T,LT>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_map->str() << "(current=" << current << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+
+//KLUDGE: cannot use Entry
+template<class KEY,class T,class LT>
+auto  SortedArrayMap<KEY,T,LT>::Iterator::operator ++ () -> const ics::Iterator<ics::pair<KEY,T>>& {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::operator ++");
+
+  if (current >= ref_map->used)
+    return *this;
+
+  if (!can_erase)
+    can_erase = true;
+  else
+    ++current;
+
+  return *this;
+}
+
+
+//KLUDGE: can create garbage! (can return local value!)
+template<class KEY,class T,class LT>
+auto SortedArrayMap<KEY,T,LT>::Iterator::operator ++ (int) -> const ics::Iterator<ics::pair<KEY,T>>&{
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::operator ++(int)");
+
+  if (current >= ref_map->used)
+    return *this;
+
+  Iterator* to_return = new Iterator(this->ref_map,current-1);
+  if (!can_erase)
+    can_erase = true;
+  else{
+    ++to_return->current;
+    ++current;
+  }
+
+  return *to_return;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::Iterator::operator == (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SortedArrayMap::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::operator ==");
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("SortedArrayMap::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::Iterator::operator != (const ics::Iterator<Entry>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SortedArrayMap::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class KEY,class T,class LT>
+bool SortedArrayMap<KEY,T,LT>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::operator !=");
+  if (ref_map != rhs.ref_map)
+    throw ComparingDifferentIteratorsError("SortedArrayMap::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+
+template<class KEY,class T,class LT>
+ics::pair<KEY,T>& SortedArrayMap<KEY,T,LT>::Iterator::operator *() const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::operator *");
+  if (!can_erase || current < 0 || current >= ref_map->used) {
+    std::ostringstream where;
+    where << current << " when size = " << ref_map->size();
+    throw IteratorPositionIllegal("SortedArrayMap::Iterator::operator * Iterator illegal: "+where.str());
+  }
+
+  return ref_map->map[current];
+}
+
+
+template<class KEY,class T,class LT>
+ics::pair<KEY,T>* SortedArrayMap<KEY,T,LT>::Iterator::operator ->() const {
+  if (expected_mod_count != ref_map->mod_count)
+    throw ConcurrentModificationError("SortedArrayMap::Iterator::operator ->");
+  if (!can_erase || current < 0 || current >= ref_map->used) {
+    std::ostringstream where;
+    where << current << " when size = " << ref_map->size();
+    throw IteratorPositionIllegal("SortedArrayMap::Iterator::operator -> Iterator illegal: "+where.str());
+  }
+
+  return &(ref_map->map[current]);
+}
+
+}
+
+#endif /* SORTED_ARRAY_MAP_HPP_ */
@@ -0,0 +1,773 @@
+#ifndef SORTED_ARRAY_SET_HPP_
+#define SORTED_ARRAY_SET_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>
+#include <functional>
+#include <algorithm>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "set.hpp"
+
+
+namespace ics {
+
+//An ArraySet whose values are kept in increasing order (by LT), so contains
+//  is a binary search: O(log N). insert and erase shift the values after the
+//  one inserted/erased: O(N), but moving contiguous values, not comparing them.
+//Two values a and b are the same iff !LT()(a,b) && !LT()(b,a).
+//The bulk operations are merges: with a range of M values, insert (union),
+//  retain (intersection), and erase (difference) are O(N+M) after sorting the
+//  range (skipped if it is already sorted, e.g., from another SortedArraySet);
+//  == and <= against another SortedArraySet are O(N+M) too.
+template<class T,class LT = std::less<T>> class SortedArraySet : public Set<T>	{
+  public:
+	  SortedArraySet();
+	  explicit SortedArraySet(int initialLength);
+	  SortedArraySet(const SortedArraySet<T,LT>& to_copy);
+	  SortedArraySet(SortedArraySet<T,LT>&& to_move);
+	  SortedArraySet(std::initializer_list<T> il);
+    SortedArraySet(ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+	  virtual ~SortedArraySet();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual bool contains   (const T& element) const;
+    virtual std::string str () const;
+
+    virtual bool contains (ics::Iterator<T>& start, const ics::Iterator<T>& stop) const;
+
+    virtual int  insert (const T& element);
+    template<class... Args>
+    int          emplace (Args&&... args); //insert(T(args...)), moving the new value in
+    virtual int  erase  (const T& element);
+    virtual void clear  ();
+
+    virtual int insert (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> insert (const ITERATOR& start, const ITERATOR& stop);
+    virtual int erase  (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    virtual int retain (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+
+    void reserve       (int n); //Room for n values without reallocating
+    void shrink_to_fit ();      //Release the unused part of the array
+
+    virtual SortedArraySet<T,LT>& operator = (const SortedArraySet<T,LT>& rhs);
+    virtual SortedArraySet<T,LT>& operator = (SortedArraySet<T,LT>&& rhs);
+    virtual bool operator == (const Set<T>& rhs) const;
+    virtual bool operator != (const Set<T>& rhs) const;
+    virtual bool operator <= (const Set<T>& rhs) const;
+    virtual bool operator <  (const Set<T>& rhs) const;
+    virtual bool operator >= (const Set<T>& rhs) const;
+    virtual bool operator >  (const Set<T>& rhs) const;
+
+    template<class T2,class LT2>
+    friend std::ostream& operator << (std::ostream& outs, const SortedArraySet<T2,LT2>& s);
+
+    //Iterators visit values in increasing order
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(SortedArraySet<T,LT>* iterate_over, int initial);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        int                   current;  //if can_erase is false, this value is unusable
+        SortedArraySet<T,LT>* ref_set;
+        int                   expected_mod_count;
+        bool                  can_erase = true;
+    };
+
+    //For explicit use: Iterator<...>& it = c.ibegin(); ... or for (Iterator<...>& it = c.ibegin(); it != c.iend(); ++it)...
+    virtual ics::Iterator<T>& ibegin () const;
+    virtual ics::Iterator<T>& iend   () const;
+
+    //For implicit use: for (... i : c)...
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    T*  set;
+    int length    = 0; //Physical length of array
+    int used      = 0; //Amount of array used
+    int mod_count = 0; //For sensing concurrent modification
+    LT  lt;
+    bool same         (const T& a, const T& b) const {return !lt(a,b) && !lt(b,a);}
+    int  lower_bound  (const T& element) const; //Index of the first value not less than element
+    bool found_at     (int i, const T& element) const;
+    int  insert_at    (int i, T element);
+    int  erase_at     (int i);
+    int  sort_unique  (T* values, int n) const;
+    T*   sorted_values(ics::Iterator<T>& start, const ics::Iterator<T>& stop, int& n) const;
+    int  merge_insert (T* values, int n);  //values are sorted with no duplicates
+    int  merge_retain (T* values, int n);
+    int  merge_erase  (T* values, int n);
+    bool subset_of    (const SortedArraySet<T,LT>& rhs) const;
+    void ensure_length(int new_length);
+    void reallocate   (int new_length);
+  };
+
+
+
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::SortedArraySet() {
+  set = new T[length];
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::SortedArraySet(int initial_length) : length(initial_length) {
+  if (length < 0)
+    length = 0;
+  set = new T[length];
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::SortedArraySet(const SortedArraySet<T,LT>& to_copy) : length(to_copy.length), used(to_copy.used) {
+  set = new T[length];
+  for (int i=0; i<to_copy.used; ++i)
+    set[i] = to_copy.set[i];
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::SortedArraySet(SortedArraySet<T,LT>&& to_move)
+  : set(to_move.set), length(to_move.length), used(to_move.used) {
+  to_move.set = nullptr;   //to_move is left empty, with length 0
+  to_move.length = 0;
+  to_move.used = 0;
+  ++to_move.mod_count;
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::SortedArraySet(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  set = new T[length];
+  insert(start,stop);
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::SortedArraySet(std::initializer_list<T> il) : length(il.size()) {
+  set = new T[length];
+  for (const T& s_elem : il)
+    set[used++] = s_elem;
+  used = sort_unique(set,used);
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::~SortedArraySet() {
+  delete[] set;
+}
+
+
+template<class T,class LT>
+inline bool SortedArraySet<T,LT>::empty() const {
+  return used == 0;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::size() const {
+  return used;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::contains (const T& element) const {
+  return found_at(lower_bound(element),element);
+}
+
+
+template<class T,class LT>
+std::string SortedArraySet<T,LT>::str() const {
+  std::ostringstream answer;
+  answer << *this << "(length=" << length << ",used=" << used << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::contains(ics::Iterator<T>& start, const ics::Iterator<T>& stop) const {
+  for (; start != stop; ++start)
+    if (!contains(*start))
+      return false;
+
+  return true;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::insert(const T& element) {
+  int i = lower_bound(element);
+  if (found_at(i,element))
+    return 0;
+
+  return insert_at(i,element);
+}
+
+
+template<class T,class LT>
+template<class... Args>
+int SortedArraySet<T,LT>::emplace(Args&&... args) {
+  T element(std::forward<Args>(args)...);
+  int i = lower_bound(element);
+  if (found_at(i,element))
+    return 0;
+
+  return insert_at(i,std::move(element));
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::erase(const T& element) {
+  int i = lower_bound(element);
+  if (found_at(i,element))
+    return erase_at(i);
+
+  return 0;
+}
+
+
+template<class T,class LT>
+void SortedArraySet<T,LT>::clear() {
+  used = 0;
+  ++mod_count;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::insert(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int n;
+  T* values = sorted_values(start,stop,n);
+  int count = merge_insert(values,n);
+  delete[] values;
+  return count;
+}
+
+
+template<class T,class LT>
+template<class ITERATOR>
+auto SortedArraySet<T,LT>::insert (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  ITERATOR i = start;
+  ics::Iterator<T>& from = i;  //so the virtual insert is called, not this one
+  return insert(from,stop);
+}
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::erase(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int n;
+  T* values = sorted_values(start,stop,n);
+  int count = merge_erase(values,n);
+  delete[] values;
+  return count;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::retain(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int n;
+  T* values = sorted_values(start,stop,n);
+  int count = merge_retain(values,n);
+  delete[] values;
+  return count;
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>& SortedArraySet<T,LT>::operator = (const SortedArraySet<T,LT>& rhs) {
+  if (this == &rhs)
+    return *this;
+  this->ensure_length(rhs.used);
+  used = rhs.used;
+  for (int i=0; i<used; ++i)
+    set[i] = rhs.set[i];
+  ++mod_count;
+  return *this;
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>& SortedArraySet<T,LT>::operator = (SortedArraySet<T,LT>&& rhs) {
+  std::swap(set,   rhs.set);  //rhs gets (and later deletes) the old array
+  std::swap(length,rhs.length);
+  std::swap(used,  rhs.used);
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::operator == (const Set<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used != rhs.size())
+    return false;
+  const SortedArraySet<T,LT>* rhsSAS = dynamic_cast<const SortedArraySet<T,LT>*>(&rhs);
+  if (rhsSAS != nullptr) {
+    for (int i=0; i<used; ++i)
+      if (!same(set[i],rhsSAS->set[i]))
+        return false;
+    return true;
+  }
+
+  for (int i=0; i<used; ++i)
+    if (!rhs.contains(set[i]))
+      return false;
+
+  return true;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::operator != (const Set<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::operator <= (const Set<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  if (used > rhs.size())
+    return false;
+  const SortedArraySet<T,LT>* rhsSAS = dynamic_cast<const SortedArraySet<T,LT>*>(&rhs);
+  if (rhsSAS != nullptr)
+    return subset_of(*rhsSAS);
+
+  for (int i=0; i<used; ++i)
+    if (!rhs.contains(set[i]))
+      return false;
+
+  return true;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::operator < (const Set<T>& rhs) const {
+  if (this == &rhs)
+    return false;
+  if (used >= rhs.size())
+    return false;
+  return *this <= rhs;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::operator >= (const Set<T>& rhs) const {
+  return rhs <= *this;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::operator > (const Set<T>& rhs) const {
+  return rhs < *this;
+}
+
+
+template<class T,class LT>
+std::ostream& operator << (std::ostream& outs, const SortedArraySet<T,LT>& s) {
+  outs << "set[";
+
+  if (!s.empty()) {
+    outs << s.set[0];
+    for (int i = 1; i < s.used; ++i)
+      outs << ","<< s.set[i];
+  }
+
+  outs << "]";
+  return outs;
+}
+
+
+//KLUDGE: memory-leak
+template<class T,class LT>
+auto SortedArraySet<T,LT>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<SortedArraySet<T,LT>*>(this),0));
+}
+
+
+//KLUDGE: memory-leak
+template<class T,class LT>
+auto SortedArraySet<T,LT>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<SortedArraySet<T,LT>*>(this),used));
+}
+
+
+template<class T,class LT>
+auto SortedArraySet<T,LT>::begin () const -> SortedArraySet<T,LT>::Iterator {
+  return Iterator(const_cast<SortedArraySet<T,LT>*>(this),0);
+}
+
+
+template<class T,class LT>
+auto SortedArraySet<T,LT>::end () const -> SortedArraySet<T,LT>::Iterator {
+  return Iterator(const_cast<SortedArraySet<T,LT>*>(this),used);
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::lower_bound(const T& element) const {
+  int low = 0, high = used;
+  while (low < high) {
+    int mid = low + (high-low)/2;
+    if (lt(set[mid],element))
+      low = mid+1;
+    else
+      high = mid;
+  }
+  return low;
+}
+
+
+//i is lower_bound(element): set[i] is not less than element, so it is the
+//  same as element iff element is not less than it
+template<class T,class LT>
+bool SortedArraySet<T,LT>::found_at(int i, const T& element) const {
+  return i < used && !lt(element,set[i]);
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::insert_at(int i, T element) {
+  this->ensure_length(used+1);
+  for (int j=used; j>i; --j)
+    set[j] = std::move(set[j-1]);
+  set[i] = std::move(element);
+  ++used;
+  ++mod_count;
+  return 1;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::erase_at(int i) {
+  for (--used; i<used; ++i)
+    set[i] = std::move(set[i+1]);
+  ++mod_count;
+  return 1;
+}
+
+
+//Sorts values[0,n) and removes duplicates, returning how many remain; sorting
+//  is skipped if the values are already in order
+template<class T,class LT>
+int SortedArraySet<T,LT>::sort_unique(T* values, int n) const {
+  if (!std::is_sorted(values,values+n,lt))
+    std::sort(values,values+n,lt);
+  return std::unique(values,values+n,[this](const T& a, const T& b){return same(a,b);}) - values;
+}
+
+
+//Returns a new[]'d array of the values in [start,stop), sorted with no
+//  duplicates, and sets n to their number
+template<class T,class LT>
+T* SortedArraySet<T,LT>::sorted_values(ics::Iterator<T>& start, const ics::Iterator<T>& stop, int& n) const {
+  int values_length = 8;
+  T* values = new T[values_length];
+  n = 0;
+  for (; start != stop; ++start) {
+    if (n == values_length) {
+      T* old_values = values;
+      values = new T[2*values_length];
+      for (int i=0; i<n; ++i)
+        values[i] = std::move(old_values[i]);
+      values_length *= 2;
+      delete[] old_values;
+    }
+    values[n++] = *start;
+  }
+
+  n = sort_unique(values,n);
+  return values;
+}
+
+
+//Merge from the back, so each value moves once; values already in the set
+//  leave a gap at the front, closed by one more pass
+template<class T,class LT>
+int SortedArraySet<T,LT>::merge_insert(T* values, int n) {
+  this->ensure_length(used+n);
+  int i = used-1, j = n-1, k = used+n-1;
+  int count = n;
+  while (j >= 0) {
+    if (i >= 0 && lt(values[j],set[i]))
+      set[k--] = std::move(set[i--]);
+    else if (i >= 0 && !lt(set[i],values[j])) {
+      set[k--] = std::move(set[i--]);
+      --j;
+      --count;
+    }else
+      set[k--] = std::move(values[j--]);
+  }
+
+  int gap = k-i;
+  if (gap > 0)
+    for (int m=k+1; m<used+n; ++m)
+      set[m-gap] = std::move(set[m]);
+
+  used += count;
+  if (count > 0)
+    ++mod_count;
+  return count;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::merge_retain(T* values, int n) {
+  int kept = 0;
+  for (int i=0, j=0; i<used; ++i) {
+    while (j < n && lt(values[j],set[i]))
+      ++j;
+    if (j < n && !lt(set[i],values[j])) {
+      if (kept != i)
+        set[kept] = std::move(set[i]);
+      ++kept;
+      ++j;
+    }
+  }
+
+  if (kept != used) {
+    used = kept;
+    ++mod_count;
+  }
+  return kept;
+}
+
+
+template<class T,class LT>
+int SortedArraySet<T,LT>::merge_erase(T* values, int n) {
+  int kept = 0;
+  for (int i=0, j=0; i<used; ++i) {
+    while (j < n && lt(values[j],set[i]))
+      ++j;
+    if (j < n && !lt(set[i],values[j]))
+      ++j;
+    else {
+      if (kept != i)
+        set[kept] = std::move(set[i]);
+      ++kept;
+    }
+  }
+
+  int count = used-kept;
+  if (count > 0) {
+    used = kept;
+    ++mod_count;
+  }
+  return count;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::subset_of(const SortedArraySet<T,LT>& rhs) const {
+  int j = 0;
+  for (int i=0; i<used; ++i) {
+    while (j < rhs.used && lt(rhs.set[j],set[i]))
+      ++j;
+    if (j == rhs.used || lt(set[i],rhs.set[j]))
+      return false;
+    ++j;
+  }
+
+  return true;
+}
+
+
+template<class T,class LT>
+void SortedArraySet<T,LT>::ensure_length(int new_length) {
+  if (length >= new_length)
+    return;
+  reallocate(std::max(new_length,2*length));
+}
+
+
+template<class T,class LT>
+void SortedArraySet<T,LT>::reallocate(int new_length) {
+  T*  old_set  = set;
+  length = new_length;
+  set = new T[length];
+  for (int i=0; i<used; ++i)
+    set[i] = std::move(old_set[i]);
+
+  delete [] old_set;
+}
+
+
+template<class T,class LT>
+void SortedArraySet<T,LT>::reserve(int n) {
+  if (length < n)
+    reallocate(n);
+}
+
+
+template<class T,class LT>
+void SortedArraySet<T,LT>::shrink_to_fit() {
+  if (length > used)
+    reallocate(used);
+}
+
+
+
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::Iterator::Iterator(SortedArraySet<T,LT>* iterate_over, int initial) : current(initial), ref_set(iterate_over) {
+  expected_mod_count = ref_set->mod_count;
+}
+
+
+template<class T,class LT>
+SortedArraySet<T,LT>::Iterator::~Iterator() {}
+
+
+template<class T,class LT>
+T SortedArraySet<T,LT>::Iterator::erase() {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("SortedArraySet::Iterator::erase Iterator cursor already erased");
+  if (current < 0 || current >= ref_set->used)
+    throw CannotEraseError("SortedArraySet::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  T to_return = ref_set->set[current];
+  ref_set->erase_at(current);
+  expected_mod_count = ref_set->mod_count;
+  return to_return;
+}
+
+
+template<class T,class LT>
+std::string SortedArraySet<T,LT>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_set->str() << "(current=" << current << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+
+template<class T,class LT>
+const ics::Iterator<T>& SortedArraySet<T,LT>::Iterator::operator ++ () {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::operator ++");
+
+  if (current >= ref_set->used)
+    return *this;
+
+  if (!can_erase)
+    can_erase = true;
+  else
+    ++current;
+
+  return *this;
+}
+
+
+//KLUDGE: can create garbage! (can return local value!)
+template<class T,class LT>
+const ics::Iterator<T>& SortedArraySet<T,LT>::Iterator::operator ++ (int) {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::operator ++(int)");
+
+  if (current >= ref_set->used)
+    return *this;
+
+  Iterator* to_return = new Iterator(this->ref_set,current-1);
+  if (!can_erase)
+    can_erase = true;
+  else{
+    ++to_return->current;
+    ++current;
+  }
+
+  return *to_return;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SortedArraySet::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::Iterator::operator == (const Iterator& rhs) const {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::operator ==");
+  if (ref_set != rhs.ref_set)
+    throw ComparingDifferentIteratorsError("SortedArraySet::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SortedArraySet::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T,class LT>
+bool SortedArraySet<T,LT>::Iterator::operator != (const Iterator& rhs) const {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::operator !=");
+  if (ref_set != rhs.ref_set)
+    throw ComparingDifferentIteratorsError("SortedArraySet::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+
+template<class T,class LT>
+T& SortedArraySet<T,LT>::Iterator::operator *() const {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::operator *");
+  if (!can_erase || current < 0 || current >= ref_set->used) {
+    std::ostringstream where;
+    where << current << " when size = " << ref_set->size();
+    throw IteratorPositionIllegal("SortedArraySet::Iterator::operator * Iterator illegal: "+where.str());
+  }
+
+  return ref_set->set[current];
+}
+
+
+template<class T,class LT>
+T* SortedArraySet<T,LT>::Iterator::operator ->() const {
+  if (expected_mod_count != ref_set->mod_count)
+    throw ConcurrentModificationError("SortedArraySet::Iterator::operator ->");
+  if (!can_erase || current < 0 || current >= ref_set->used) {
+    std::ostringstream where;
+    where << current << " when size = " << ref_set->size();
+    throw IteratorPositionIllegal("SortedArraySet::Iterator::operator -> Iterator illegal: "+where.str());
+  }
+
+  return &ref_set->set[current];
+}
+
+}
+
+#endif /* SORTED_ARRAY_SET_HPP_ */
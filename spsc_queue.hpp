@@ -0,0 +1,639 @@
+#ifndef SPSC_QUEUE_HPP_
+#define SPSC_QUEUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <initializer_list>
+#include <utility>
+#include <atomic>
+#include <cstddef>
+#include "ics_exceptions.hpp"
+#include "iterator.hpp"
+#include "queue.hpp"
+#include "concurrency.hpp"
+
+
+namespace ics {
+
+//A bounded queue (ring buffer) shared by exactly two threads, without locks:
+//  one producer thread calls enqueue/try_enqueue/emplace/try_emplace, and
+//  one consumer thread calls dequeue/try_dequeue/peek/clear; either may call
+//  empty/size/capacity (whose answers may be stale by the time they return).
+//All other operations (copying, assignment, ==, str, <<, iterators) must be
+//  used only when neither thread is enqueueing or dequeueing.
+//
+//front/rear count every dequeue/enqueue (they are never reduced modulo the
+//  array length), so the queue is empty when front == rear and full when
+//  rear-front == capacity; the array length is a power of 2, so a count's
+//  index is count & mask. The producer writes the value, then publishes it
+//  by storing rear with release; the consumer loads rear with acquire before
+//  reading the value (and symmetrically for front, freeing a cell).
+//Each thread also caches the other's counter, reloading it (a cache miss)
+//  only when the cached value says the queue is full/empty.
+template<class T> class SPSCQueue : public Queue<T>  {
+  public:
+    explicit SPSCQueue(int capacity = 1024); //Rounded up to a power of 2
+    SPSCQueue(const SPSCQueue<T>& to_copy);
+    SPSCQueue(SPSCQueue<T>&& to_move);
+    SPSCQueue(std::initializer_list<T> il);
+    SPSCQueue(int capacity, ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    virtual ~SPSCQueue();
+
+    virtual bool empty      () const;
+    virtual int  size       () const;
+    virtual T&   peek       () const;
+    virtual std::string str () const;
+    int capacity            () const;
+
+    virtual int  enqueue (const T& element);  //Throws FullError if full
+    template<class... Args>
+    int          emplace (Args&&... args);    //enqueue(T(args...)), moving the new value in
+    virtual T    dequeue ();                  //Throws EmptyError if empty
+    virtual void clear   ();
+
+    //Return false (changing nothing) instead of throwing FullError/EmptyError
+    bool try_enqueue (const T& element);
+    template<class... Args>
+    bool try_emplace (Args&&... args);
+    bool try_dequeue (T& into);
+
+    virtual int enqueue (ics::Iterator<T>& start, const ics::Iterator<T>& stop);
+    template<class ITERATOR>  //e.g., c.begin(),c.end() for any data structure c
+    ics::if_concrete_iterator<ITERATOR,T> enqueue (const ITERATOR& start, const ITERATOR& stop);
+
+    virtual SPSCQueue<T>& operator = (const SPSCQueue<T>& rhs);
+    virtual SPSCQueue<T>& operator = (SPSCQueue<T>&& rhs);
+    virtual bool operator == (const Queue<T>& rhs) const;
+    virtual bool operator != (const Queue<T>& rhs) const;
+
+    template<class T2>
+    friend std::ostream& operator << (std::ostream& outs, const SPSCQueue<T2>& q);
+
+    class Iterator final : public ics::Iterator<T> {
+      public:
+        //KLUDGE should be callable only in begin/end
+        Iterator(SPSCQueue<T>* iterate_over, std::size_t initial);
+        virtual ~Iterator();
+        virtual T           erase();
+        virtual std::string str  () const;
+        virtual const ics::Iterator<T>& operator ++ ();
+        virtual const ics::Iterator<T>& operator ++ (int);
+        virtual bool operator == (const ics::Iterator<T>& rhs) const;
+        virtual bool operator != (const ics::Iterator<T>& rhs) const;
+        //Same-type comparisons (e.g., by range-for): no dynamic_cast, no virtual call
+        bool operator == (const Iterator& rhs) const;
+        bool operator != (const Iterator& rhs) const;
+        virtual T& operator *  () const;
+        virtual T* operator -> () const;
+      private:
+        std::size_t   current;  //if can_erase is false, this value is unusable
+        SPSCQueue<T>* ref_queue;
+        std::size_t   expected_front;     //enqueue/dequeue don't change mod_count
+        std::size_t   expected_rear;      //  (it isn't atomic), but do change these
+        int           expected_mod_count;
+        bool          can_erase = true;
+        bool          is_stale () const;
+    };
+
+    //For explicit use: Iterator<...>& it = c.ibegin(); ... or for (Iterator<...>& it = c.ibegin(); it != c.iend(); ++it)...
+    virtual ics::Iterator<T>& ibegin () const;
+    virtual ics::Iterator<T>& iend   () const;
+
+    //For implicit use: for (... i : c)...
+    virtual Iterator begin () const;
+    virtual Iterator end   () const;
+
+  private:
+    //The padding keeps the producer's and consumer's counters (and the
+    //  fields both only read) on different cache lines
+    T*          queue;
+    std::size_t mask      = 0;  //Array length-1
+    int         mod_count = 0;  //For sensing concurrent modification (by erase/=)
+    char        pad_0[CACHE_LINE_SIZE];
+    std::atomic<std::size_t> rear {0};        //Written only by the producer
+    std::size_t              front_cache = 0; //Producer's last load of front
+    char        pad_1[CACHE_LINE_SIZE];
+    std::atomic<std::size_t> front{0};        //Written only by the consumer
+    mutable std::size_t      rear_cache  = 0; //Consumer's last load of rear (peek updates it)
+    char        pad_2[CACHE_LINE_SIZE];
+    T*   producer_cell ();                    //nullptr if full
+    T*   consumer_cell () const;              //nullptr if empty
+    int  erase_at      (std::size_t i);
+    void reallocate    (int new_capacity);    //Discards all values
+    bool is_in         (std::size_t i) const;
+    static int rounded_capacity (int capacity);
+  };
+
+
+
+
+
+template<class T>
+SPSCQueue<T>::SPSCQueue(int capacity) {
+  capacity = rounded_capacity(capacity);
+  queue = new T[capacity];
+  mask = capacity-1;
+}
+
+
+template<class T>
+SPSCQueue<T>::SPSCQueue(const SPSCQueue<T>& to_copy) : SPSCQueue<T>(to_copy.capacity()) {
+  for (const T& q_elem : to_copy)
+    enqueue(q_elem);
+}
+
+
+//to_move is left empty, with capacity 0
+template<class T>
+SPSCQueue<T>::SPSCQueue(SPSCQueue<T>&& to_move) : queue(nullptr) {
+  *this = std::move(to_move);
+}
+
+
+template<class T>
+SPSCQueue<T>::SPSCQueue(int capacity, ics::Iterator<T>& start, const ics::Iterator<T>& stop)
+  : SPSCQueue<T>(capacity) {
+  enqueue(start,stop);
+}
+
+
+template<class T>
+SPSCQueue<T>::SPSCQueue(std::initializer_list<T> il) : SPSCQueue<T>(int(il.size())) {
+  for (const T& q_elem : il)
+    enqueue(q_elem);
+}
+
+
+template<class T>
+SPSCQueue<T>::~SPSCQueue() {
+  delete[] queue;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::empty() const {
+  return front.load(std::memory_order_acquire) == rear.load(std::memory_order_acquire);
+}
+
+
+//front is loaded first: rear only grows, so it is >= any earlier front
+template<class T>
+inline int SPSCQueue<T>::size() const {
+  std::size_t f = front.load(std::memory_order_acquire);
+  return rear.load(std::memory_order_acquire) - f;
+}
+
+
+template<class T>
+T& SPSCQueue<T>::peek () const {
+  T* cell = consumer_cell();
+  if (cell == nullptr)
+    throw EmptyError("SPSCQueue::peek");
+
+  return *cell;
+}
+
+
+template<class T>
+std::string SPSCQueue<T>::str() const {
+  std::ostringstream answer;
+  answer << "queue[";
+  std::size_t f = front.load(), used = rear.load()-f;
+  for (std::size_t i=0; i<=mask && queue != nullptr; ++i) {
+    if (((i-f) & mask) < used)
+      answer << queue[i];
+    answer << (i == mask ? "" : ",");
+  }
+  answer << "](capacity=" << capacity() << ",front=" << front.load() << ",rear=" << rear.load()
+         << ",mod_count=" << mod_count << ")";
+  return answer.str();
+}
+
+
+template<class T>
+int SPSCQueue<T>::capacity() const {
+  return queue == nullptr ? 0 : int(mask)+1;
+}
+
+
+template<class T>
+int SPSCQueue<T>::enqueue(const T& element) {
+  if (!try_enqueue(element))
+    throw FullError("SPSCQueue::enqueue");
+  return 1;
+}
+
+
+template<class T>
+template<class... Args>
+int SPSCQueue<T>::emplace(Args&&... args) {
+  if (!try_emplace(std::forward<Args>(args)...))
+    throw FullError("SPSCQueue::emplace");
+  return 1;
+}
+
+
+template<class T>
+T SPSCQueue<T>::dequeue() {
+  T answer;
+  if (!try_dequeue(answer))
+    throw EmptyError("SPSCQueue::dequeue");
+
+  return answer;
+}
+
+
+//By the consumer: it discards every value enqueued so far
+template<class T>
+void SPSCQueue<T>::clear() {
+  rear_cache = rear.load(std::memory_order_acquire);
+  front.store(rear_cache,std::memory_order_release);
+}
+
+
+template<class T>
+bool SPSCQueue<T>::try_enqueue(const T& element) {
+  T* cell = producer_cell();
+  if (cell == nullptr)
+    return false;
+
+  *cell = element;
+  rear.store(rear.load(std::memory_order_relaxed)+1,std::memory_order_release);
+  return true;
+}
+
+
+template<class T>
+template<class... Args>
+bool SPSCQueue<T>::try_emplace(Args&&... args) {
+  T* cell = producer_cell();
+  if (cell == nullptr)
+    return false;
+
+  *cell = T(std::forward<Args>(args)...);
+  rear.store(rear.load(std::memory_order_relaxed)+1,std::memory_order_release);
+  return true;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::try_dequeue(T& into) {
+  T* cell = consumer_cell();
+  if (cell == nullptr)
+    return false;
+
+  into = std::move(*cell);
+  front.store(front.load(std::memory_order_relaxed)+1,std::memory_order_release);
+  return true;
+}
+
+
+template<class T>
+int SPSCQueue<T>::enqueue(ics::Iterator<T>& start, const ics::Iterator<T>& stop) {
+  int count = 0;
+  for (; start != stop; ++start)
+    count += enqueue(*start);
+
+  return count;
+}
+
+
+template<class T>
+template<class ITERATOR>
+auto SPSCQueue<T>::enqueue (const ITERATOR& start, const ITERATOR& stop) -> ics::if_concrete_iterator<ITERATOR,T> {
+  int count = 0;
+  for (ITERATOR i = start; i != stop; ++i)
+    count += enqueue(*i);
+
+  return count;
+}
+
+
+template<class T>
+SPSCQueue<T>& SPSCQueue<T>::operator = (const SPSCQueue<T>& rhs) {
+  if (this == &rhs)
+    return *this;
+  reallocate(rhs.capacity());
+  for (const T& q_elem : rhs)
+    enqueue(q_elem);
+  ++mod_count;
+  return *this;
+}
+
+
+//The atomics can't be swapped, so rhs's are stored here and reset
+template<class T>
+SPSCQueue<T>& SPSCQueue<T>::operator = (SPSCQueue<T>&& rhs) {
+  if (this == &rhs)
+    return *this;
+  delete[] queue;
+  queue = rhs.queue;
+  mask  = rhs.mask;
+  front.store(rhs.front.load());
+  rear.store (rhs.rear.load());
+  front_cache = front.load();
+  rear_cache  = rear.load();
+
+  rhs.queue = nullptr;
+  rhs.mask  = 0;
+  rhs.front.store(0);
+  rhs.rear.store(0);
+  rhs.front_cache = rhs.rear_cache = 0;
+  ++mod_count;
+  ++rhs.mod_count;
+  return *this;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::operator == (const Queue<T>& rhs) const {
+  if (this == &rhs)
+    return true;
+  int used = this->size();
+  if (used != rhs.size())
+    return false;
+  // Uses ! and ==, so != on T need not be defined
+  std::size_t f = front.load();
+  const SPSCQueue<T>* rhsSQ = dynamic_cast<const SPSCQueue<T>*>(&rhs);
+  if (rhsSQ != nullptr) {
+    std::size_t rhs_f = rhsSQ->front.load();
+    for (int i=0; i<used; ++i)
+      if (!(queue[(f+i) & mask] == rhsSQ->queue[(rhs_f+i) & rhsSQ->mask]))
+        return false;
+    return true;
+  }
+
+  bool answer = true;
+  ics::Iterator<T>& rhs_i = rhs.ibegin();
+  for (int i=0; answer && i<used; ++i,++rhs_i)
+    answer = queue[(f+i) & mask] == *rhs_i;
+  delete &rhs_i;  //ibegin returns a heap-allocated iterator
+  return answer;
+}
+
+template<class T>
+bool SPSCQueue<T>::operator != (const Queue<T>& rhs) const {
+  return !(*this == rhs);
+}
+
+
+template<class T>
+std::ostream& operator << (std::ostream& outs, const SPSCQueue<T>& q) {
+  outs << "queue[";
+
+  std::size_t start = q.front.load(), stop = q.rear.load();
+  for (std::size_t i=start; i!=stop; ++i)
+    outs << (i == start ? "" : ",") << q.queue[i & q.mask];
+
+  outs << "]:rear";
+  return outs;
+}
+
+//KLUDGE: memory-leak
+template<class T>
+auto SPSCQueue<T>::ibegin () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<SPSCQueue<T>*>(this),front.load()));
+}
+
+
+//KLUDGE: memory-leak
+template<class T>
+auto SPSCQueue<T>::iend () const -> ics::Iterator<T>& {
+  return *(new Iterator(const_cast<SPSCQueue<T>*>(this),rear.load()));
+}
+
+
+template<class T>
+auto SPSCQueue<T>::begin () const -> SPSCQueue<T>::Iterator {
+  return Iterator(const_cast<SPSCQueue<T>*>(this),front.load());
+}
+
+
+template<class T>
+auto SPSCQueue<T>::end () const -> SPSCQueue<T>::Iterator {
+  return Iterator(const_cast<SPSCQueue<T>*>(this),rear.load());
+}
+
+
+//Only the producer stores rear, so it can load it relaxed
+template<class T>
+T* SPSCQueue<T>::producer_cell() {
+  std::size_t r = rear.load(std::memory_order_relaxed);
+  if (r-front_cache == std::size_t(capacity())) {
+    front_cache = front.load(std::memory_order_acquire);
+    if (r-front_cache == std::size_t(capacity()))
+      return nullptr;
+  }
+  return &queue[r & mask];
+}
+
+
+//Only the consumer stores front, so it can load it relaxed
+template<class T>
+T* SPSCQueue<T>::consumer_cell() const {
+  std::size_t f = front.load(std::memory_order_relaxed);
+  if (f == rear_cache) {
+    rear_cache = rear.load(std::memory_order_acquire);
+    if (f == rear_cache)
+      return nullptr;
+  }
+  return &queue[f & mask];
+}
+
+
+template<class T>
+int SPSCQueue<T>::erase_at(std::size_t i) {
+  std::size_t r = rear.load();
+  for (std::size_t to=i; to+1 != r; ++to)
+    queue[to & mask] = std::move(queue[(to+1) & mask]);
+  rear.store(r-1);
+  front_cache = front.load();
+  rear_cache  = r-1;
+  ++mod_count;
+  return 1;
+}
+
+
+template<class T>
+void SPSCQueue<T>::reallocate(int new_capacity) {
+  new_capacity = rounded_capacity(new_capacity);
+  if (queue == nullptr || new_capacity != capacity()) {
+    delete[] queue;
+    queue = new T[new_capacity];
+    mask  = new_capacity-1;
+  }
+  front.store(0);
+  rear.store(0);
+  front_cache = rear_cache = 0;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::is_in(std::size_t i) const {
+  return i-front.load() < rear.load()-front.load();
+}
+
+
+template<class T>
+int SPSCQueue<T>::rounded_capacity(int capacity) {
+  int answer = 1;
+  while (answer < capacity)
+    answer *= 2;
+  return answer;
+}
+
+
+
+
+
+template<class T>
+SPSCQueue<T>::Iterator::Iterator(SPSCQueue<T>* iterate_over, std::size_t initial) : current(initial), ref_queue(iterate_over) {
+  expected_front     = ref_queue->front.load();
+  expected_rear      = ref_queue->rear.load();
+  expected_mod_count = ref_queue->mod_count;
+}
+
+template<class T>
+SPSCQueue<T>::Iterator::~Iterator() {}
+
+template<class T>
+T SPSCQueue<T>::Iterator::erase() {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::erase");
+  if (!can_erase)
+    throw CannotEraseError("SPSCQueue::Iterator::erase Iterator cursor already erased");
+  if (!ref_queue->is_in(current))
+    throw CannotEraseError("SPSCQueue::Iterator::erase Iterator cursor beyond data structure");
+
+  can_erase = false;
+  T to_return = ref_queue->queue[current & ref_queue->mask];
+  ref_queue->erase_at(current);
+  expected_rear      = ref_queue->rear.load();
+  expected_mod_count = ref_queue->mod_count;
+  return to_return;
+}
+
+
+template<class T>
+std::string SPSCQueue<T>::Iterator::str() const {
+  std::ostringstream answer;
+  answer << ref_queue->str() << "(current=" << current << ",expected_mod_count=" << expected_mod_count << ",can_erase=" << can_erase << ")";
+  return answer.str();
+}
+
+
+template<class T>
+const ics::Iterator<T>& SPSCQueue<T>::Iterator::operator ++ () {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::operator ++");
+
+  if (current == ref_queue->rear.load())
+    return *this;
+
+  if (!can_erase)
+    can_erase = true;
+  else
+    ++current;
+
+  return *this;
+}
+
+
+//KLUDGE: creates garbage! (can return local value!)
+template<class T>
+const ics::Iterator<T>& SPSCQueue<T>::Iterator::operator ++ (int) {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::operator ++(int)");
+
+  if (current == ref_queue->rear.load())
+    return *this;
+
+  Iterator* to_return = new Iterator(*this);
+  if (!can_erase)
+    can_erase = true;
+  else
+    ++current;
+
+  return *to_return;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::Iterator::operator == (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SPSCQueue::Iterator::operator ==");
+  return *this == *rhsASI;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::Iterator::operator == (const Iterator& rhs) const {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::operator ==");
+  if (ref_queue != rhs.ref_queue)
+    throw ComparingDifferentIteratorsError("SPSCQueue::Iterator::operator ==");
+
+  return current == rhs.current;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::Iterator::operator != (const ics::Iterator<T>& rhs) const {
+  const Iterator* rhsASI = dynamic_cast<const Iterator*>(&rhs);
+  if (rhsASI == 0)
+    throw IteratorTypeError("SPSCQueue::Iterator::operator !=");
+  return *this != *rhsASI;
+}
+
+
+template<class T>
+bool SPSCQueue<T>::Iterator::operator != (const Iterator& rhs) const {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::operator !=");
+  if (ref_queue != rhs.ref_queue)
+    throw ComparingDifferentIteratorsError("SPSCQueue::Iterator::operator !=");
+
+  return current != rhs.current;
+}
+
+
+template<class T>
+T& SPSCQueue<T>::Iterator::operator *() const {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::operator *");
+  if (!can_erase || !ref_queue->is_in(current)) {
+    std::ostringstream where;
+    where << current << " when front = " << ref_queue->front.load() << " and rear = " << ref_queue->rear.load();
+    throw IteratorPositionIllegal("SPSCQueue::Iterator::operator * Iterator illegal: "+where.str());
+  }
+
+  return ref_queue->queue[current & ref_queue->mask];
+}
+
+
+template<class T>
+T* SPSCQueue<T>::Iterator::operator ->() const {
+  if (is_stale())
+    throw ConcurrentModificationError("SPSCQueue::Iterator::operator ->");
+  if (!can_erase || !ref_queue->is_in(current)) {
+    std::ostringstream where;
+    where << current << " when front = " << ref_queue->front.load() << " and rear = " << ref_queue->rear.load();
+    throw IteratorPositionIllegal("SPSCQueue::Iterator::operator -> Iterator illegal: "+where.str());
+  }
+
+  return &ref_queue->queue[current & ref_queue->mask];
+}
+
+
+template<class T>
+bool SPSCQueue<T>::Iterator::is_stale() const {
+  return expected_mod_count != ref_queue->mod_count ||
+         expected_front     != ref_queue->front.load() ||
+         expected_rear      != ref_queue->rear.load();
+}
+
+}
+
+#endif /* SPSC_QUEUE_HPP_ */
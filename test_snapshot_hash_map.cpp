@@ -0,0 +1,63 @@
+//Tests SnapshotHashMap made from a HashMap that is rehashing incrementally:
+//  readers (calling str, which walks every bin) run while a writer puts, so
+//  no snapshot may be changed after it is published. Build and run with a
+//  race detector, e.g.,
+//    g++ -std=c++11 -g -fsanitize=thread test_snapshot_hash_map.cpp epoch_reclamation.cpp ics_exceptions.cpp -lpthread
+//  It prints "passed" (and the detector reports nothing) if all is well.
+
+#include <string>
+#include <iostream>
+#include <cassert>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include "hash_map.hpp"
+#include "snapshot_hash_map.hpp"
+
+
+int main() {
+  ics::HashMap<int,int> initial;
+  initial.incremental_rehash(1);
+  for (int i=0; i<100; ++i)         //Leaves initial in the middle of a rehash
+    initial.put(-1-i,i);
+  std::string initial_str = initial.str();
+  assert(initial_str.find("old_bins") != std::string::npos);
+
+  ics::SnapshotHashMap<int,int> m(initial);
+  assert(initial.str() == initial_str);  //Copying did not change initial
+  assert(m.size() == 100);
+  m.read([&initial] (const ics::HashMap<int,int>& s) {assert(s == initial);});
+
+  const int readers = 3, puts = 2000;
+  std::atomic<bool> done(false);
+  std::vector<std::thread> reader_threads;
+  for (int r=0; r<readers; ++r)
+    reader_threads.push_back(std::thread([&m,&done] {
+      while (!done.load()) {
+        assert(m.str() != "");
+        int last_size = m.read([] (const ics::HashMap<int,int>& s) {
+          int count = 0;
+          for (auto i = s.begin(); i != s.end(); ++i)
+            ++count;
+          assert(count == s.size());
+          return count;
+        });
+        assert(last_size >= 100);
+      }
+    }));
+
+  for (int i=0; i<puts; ++i)
+    m.put(i,i);
+  done.store(true);
+  for (std::thread& t : reader_threads)
+    t.join();
+
+  assert(m.size() == 100+puts);
+  for (int i=0; i<puts; ++i)
+    assert(m.get(i) == i);
+  for (int i=0; i<100; ++i)
+    assert(m.get(-1-i) == i);
+
+  std::cout << "passed" << std::endl;
+  return 0;
+}
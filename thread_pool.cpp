@@ -0,0 +1,145 @@
+#include "thread_pool.hpp"
+
+namespace ics {
+
+//The pool (and worker index) of the thread running, if it is a worker
+static thread_local ThreadPool* this_pool   = nullptr;
+static thread_local int         this_worker = -1;
+
+
+ThreadPool::ThreadPool(int threads) {
+  if (threads <= 0)
+    threads = std::thread::hardware_concurrency();
+  if (threads <= 0)
+    threads = 1;
+  worker_count = threads;
+  workers = new Worker[worker_count];
+  for (int i=0; i<worker_count; ++i) {
+    workers[i].seed = 2*i+1;
+    workers[i].thread = std::thread(&ThreadPool::run_worker,this,i);
+  }
+}
+
+
+ThreadPool::~ThreadPool() {
+  try {
+    wait();
+  } catch (...) {
+    //A destructor must not throw; the exception is lost
+  }
+  {
+    std::lock_guard<std::mutex> guard(lock);
+    stopping = true;
+  }
+  work_available.notify_all();
+  for (int i=0; i<worker_count; ++i)
+    workers[i].thread.join();
+  delete[] workers;
+}
+
+
+int ThreadPool::size () const {
+  return worker_count;
+}
+
+
+void ThreadPool::wait() {
+  if (this_pool == this)
+    throw IcsError("ThreadPool::wait: called by a task (which would wait for itself)");
+
+  std::unique_lock<std::mutex> guard(lock);
+  all_finished.wait(guard, [this] () {return unfinished.load() == 0;});
+  if (first_exception) {
+    std::exception_ptr to_throw = first_exception;
+    first_exception = nullptr;
+    std::rethrow_exception(to_throw);
+  }
+}
+
+
+//queued is incremented before sleepers is checked, and a worker increments
+//  sleepers before checking queued (both seq_cst): so either this sees the
+//  sleeper (and notifies it, under the lock), or the sleeper sees the task
+void ThreadPool::submit_task(Task* task) {
+  unfinished.fetch_add(1);
+  queued.fetch_add(1);
+  if (this_pool == this)
+    workers[this_worker].deque.push(task);
+  else
+    submitted.wait_enqueue(task);
+
+  if (sleepers.load() > 0) {
+    std::lock_guard<std::mutex> guard(lock);
+    work_available.notify_one();
+  }
+}
+
+
+//Own deque, then the shared queue, then the other workers' deques, starting
+//  at a random one (so thieves spread out over the victims)
+bool ThreadPool::take_task(int index, Task*& task) {
+  Worker& me = workers[index];
+  bool found = me.deque.try_pop(task) || submitted.try_dequeue(task);
+  if (!found && worker_count > 1) {
+    me.seed ^= me.seed << 13;
+    me.seed ^= me.seed >> 17;
+    me.seed ^= me.seed << 5;
+    int start = me.seed % worker_count;
+    for (int i=0; i<worker_count && !found; ++i) {
+      int victim = (start+i) % worker_count;
+      found = victim != index && workers[victim].deque.try_steal(task);
+    }
+  }
+
+  if (found)
+    queued.fetch_sub(1);
+  return found;
+}
+
+
+void ThreadPool::run_task(Task* task) {
+  try {
+    (*task)();
+  } catch (...) {
+    std::lock_guard<std::mutex> guard(lock);
+    if (!first_exception)
+      first_exception = std::current_exception();
+  }
+  delete task;
+
+  if (unfinished.fetch_sub(1) == 1) {
+    std::lock_guard<std::mutex> guard(lock);
+    all_finished.notify_all();
+  }
+}
+
+
+//When tasks are queued but none was found (e.g., one is being pushed, or a
+//  steal lost a race), retry soon; when none are queued, sleep
+void ThreadPool::run_worker(int index) {
+  this_pool   = this;
+  this_worker = index;
+
+  Backoff backoff;
+  for (;;) {
+    Task* task;
+    if (take_task(index,task)) {
+      run_task(task);
+      backoff.reset();
+      continue;
+    }
+    if (queued.load() > 0) {
+      backoff.pause();
+      continue;
+    }
+
+    std::unique_lock<std::mutex> guard(lock);
+    sleepers.fetch_add(1);
+    work_available.wait(guard, [this] () {return queued.load() > 0 || stopping.load();});
+    sleepers.fetch_sub(1);
+    if (stopping && queued.load() == 0)
+      return;
+  }
+}
+
+}
@@ -0,0 +1,121 @@
+#ifndef THREAD_POOL_HPP_
+#define THREAD_POOL_HPP_
+
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <exception>
+#include <utility>
+#include "ics_exceptions.hpp"
+#include "work_stealing_deque.hpp"
+#include "mpmc_queue.hpp"
+
+
+namespace ics {
+
+//Runs tasks (anything callable with no arguments) on a fixed set of worker
+//  threads, balancing the load by work stealing: each worker has its own
+//  WorkStealingDeque; a task submitted by a task goes on its worker's deque
+//  (popped LIFO by that worker, so recently submitted, cache-warm tasks run
+//  first); a task submitted by any other thread goes on a shared MPMCQueue.
+//  A worker whose deque is empty takes from the shared queue, then steals
+//  the oldest task (often the biggest, for divide and conquer) from another
+//  worker's deque; a worker that finds nothing sleeps until a submit.
+//
+//ThreadPool pool;
+//  pool.submit([&]{...});                           //Returns immediately
+//  pool.parallel_for(0,n,[&](int i){...});          //Returns when all f(i) are done
+//  pool.wait();                                     //Returns when all tasks are done
+//Tasks may submit more tasks (e.g., one per neighbor in a graph traversal),
+//  but must not wait/parallel_for: only threads outside the pool may.
+class ThreadPool {
+  public:
+    explicit ThreadPool(int threads = 0);  //0 means one per hardware thread
+    ThreadPool(const ThreadPool& to_copy) = delete;
+    ThreadPool& operator = (const ThreadPool& rhs) = delete;
+    ~ThreadPool();                         //Waits for all tasks, then stops the workers
+
+    int size () const;
+
+    template<class F>
+    void submit (F&& task);
+
+    //Wait until every task submitted (including by tasks) has finished; then
+    //  rethrow the first exception any task threw (since the last wait)
+    void wait ();
+
+    //f(i) for every i in [low,high): the range is split in half (submitting
+    //  the upper half, for stealing) until at most grain remain; then waits
+    template<class F>
+    void parallel_for (int low, int high, const F& f, int grain = 1);
+
+  private:
+    typedef std::function<void()> Task;
+
+    class Worker {
+      public:
+        WorkStealingDeque<Task*> deque;
+        std::thread              thread;
+        unsigned                 seed = 1;  //For choosing a victim to steal from
+    };
+
+    Worker*            workers;
+    int                worker_count;
+    MPMCQueue<Task*>   submitted;        //By threads outside the pool
+    std::atomic<int>   queued    {0};    //Tasks submitted but not yet taken by a worker
+    std::atomic<int>   unfinished{0};    //Tasks submitted but not yet finished
+    std::atomic<int>   sleepers  {0};    //Workers waiting for work_available
+    std::atomic<bool>  stopping  {false};
+    std::mutex              lock;
+    std::condition_variable work_available;
+    std::condition_variable all_finished;
+    std::exception_ptr      first_exception;
+
+    void submit_task (Task* task);
+    bool take_task   (int index, Task*& task);
+    void run_task    (Task* task);
+    void run_worker  (int index);
+
+    template<class F>
+    void submit_range (int low, int high, const F& f, int grain);
+};
+
+
+
+
+
+template<class F>
+void ThreadPool::submit(F&& task) {
+  submit_task(new Task(std::forward<F>(task)));
+}
+
+
+template<class F>
+void ThreadPool::parallel_for(int low, int high, const F& f, int grain) {
+  if (low >= high)
+    return;
+  submit_range(low,high,f,(grain < 1 ? 1 : grain));
+  wait();
+}
+
+
+//f is referenced (not copied) by the tasks: parallel_for waits for them
+template<class F>
+void ThreadPool::submit_range(int low, int high, const F& f, int grain) {
+  submit([this,low,high,&f,grain] () {
+    int h = high;
+    while (h-low > grain) {
+      int mid = low + (h-low)/2;
+      submit_range(mid,h,f,grain);
+      h = mid;
+    }
+    for (int i=low; i<h; ++i)
+      f(i);
+  });
+}
+
+}
+
+#endif /* THREAD_POOL_HPP_ */
@@ -0,0 +1,230 @@
+#ifndef WORK_STEALING_DEQUE_HPP_
+#define WORK_STEALING_DEQUE_HPP_
+
+#include <string>
+#include <iostream>
+#include <sstream>
+#include <atomic>
+#include <cstddef>
+#include <type_traits>
+#include "ics_exceptions.hpp"
+#include "concurrency.hpp"
+
+
+namespace ics {
+
+//A stack owned by one thread, from which other threads can "steal" (a
+//  Chase-Lev work-stealing deque, used by ThreadPool): like ArrayStack, the
+//  owner pushes/pops values at the top of a growable array; any other thread
+//  may try_steal the value at the bottom (the oldest). The owner never locks
+//  or waits; it uses a compare-and-swap only to pop the last value (when it
+//  may race a thief). Thieves CAS bottom, so each value is taken just once.
+//push/pop/try_pop are only for the owner; try_steal, empty, and size (whose
+//  answers may be stale by the time they return) are for any thread; str and
+//  << are only for when no thread is using the deque.
+//
+//Thieves read values that the owner may be overwriting (in a slot that a
+//  pop then push reused), before their CAS fails; so values are stored in
+//  atomics, and T must be trivially copyable (e.g., a pointer to a task).
+//Growing copies the values into an array twice as long: a thief may still
+//  be reading the old one, so it is kept (on a list) until destruction; the
+//  lengths double, so the old arrays total less than the current one.
+template<class T> class WorkStealingDeque  {
+  static_assert(std::is_trivially_copyable<T>::value, "WorkStealingDeque: T must be trivially copyable");
+  public:
+    explicit WorkStealingDeque(int initial_length = 64);  //Rounded up to a power of 2
+    WorkStealingDeque(const WorkStealingDeque<T>& to_copy) = delete;
+    WorkStealingDeque<T>& operator = (const WorkStealingDeque<T>& rhs) = delete;
+    ~WorkStealingDeque();
+
+    bool empty      () const;
+    int  size       () const;
+    std::string str () const;
+
+    void push      (const T& element);  //By the owner
+    T    pop       ();                  //By the owner; throws EmptyError if empty
+    bool try_pop   (T& into);           //By the owner; false if empty
+    bool try_steal (T& into);           //By any thread; false if empty or another took it
+
+    template<class T2>
+    friend std::ostream& operator << (std::ostream& outs, const WorkStealingDeque<T2>& d);
+
+  private:
+    //Indexes (of top/bottom) are never reduced modulo the length
+    class Array {
+      public:
+        Array(std::ptrdiff_t length) : mask(length-1), values(new std::atomic<T>[length]) {}
+        ~Array() {delete[] values;}
+        std::ptrdiff_t length () const                        {return mask+1;}
+        T              get    (std::ptrdiff_t i) const        {return values[i & mask].load(std::memory_order_relaxed);}
+        void           put    (std::ptrdiff_t i, const T& v)  {values[i & mask].store(v,std::memory_order_relaxed);}
+        std::ptrdiff_t  mask;
+        std::atomic<T>* values;
+        Array*          retired_next = nullptr;  //List of arrays grown out of
+    };
+
+    //The padding keeps the owner's and thieves' indexes on different cache lines
+    std::atomic<Array*>         array;
+    Array*                      retired = nullptr; //Only the owner grows/retires arrays
+    char                        pad_0[CACHE_LINE_SIZE];
+    std::atomic<std::ptrdiff_t> top   {0}; //Index one beyond top value: written only by the owner
+    char                        pad_1[CACHE_LINE_SIZE];
+    std::atomic<std::ptrdiff_t> bottom{0}; //Index of bottom value: advanced by any CAS
+    char                        pad_2[CACHE_LINE_SIZE];
+    Array* grow (Array* a, std::ptrdiff_t b, std::ptrdiff_t t);
+  };
+
+
+
+
+
+template<class T>
+WorkStealingDeque<T>::WorkStealingDeque(int initial_length) {
+  std::ptrdiff_t length = 1;
+  while (length < initial_length)
+    length *= 2;
+  array.store(new Array(length),std::memory_order_relaxed);
+}
+
+
+template<class T>
+WorkStealingDeque<T>::~WorkStealingDeque() {
+  delete array.load();
+  while (retired != nullptr) {
+    Array* to_delete = retired;
+    retired = retired->retired_next;
+    delete to_delete;
+  }
+}
+
+
+template<class T>
+bool WorkStealingDeque<T>::empty() const {
+  return this->size() == 0;
+}
+
+
+//bottom is loaded first: a pop can leave top (briefly) below bottom
+template<class T>
+int WorkStealingDeque<T>::size() const {
+  std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+  std::ptrdiff_t t = top.load(std::memory_order_acquire);
+  return t > b ? int(t-b) : 0;
+}
+
+
+template<class T>
+std::string WorkStealingDeque<T>::str() const {
+  std::ostringstream answer;
+  Array* a = array.load();
+  answer << "work_stealing_deque[";
+  for (std::ptrdiff_t i=bottom.load(); i<top.load(); ++i)
+    answer << (i == bottom.load() ? "" : ",") << a->get(i);
+  answer << "](length=" << a->length() << ",bottom=" << bottom.load() << ",top=" << top.load() << ")";
+  return answer.str();
+}
+
+
+//top is stored with release, so a thief loading it sees the value
+template<class T>
+void WorkStealingDeque<T>::push(const T& element) {
+  std::ptrdiff_t t = top.load(std::memory_order_relaxed);
+  std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+  Array* a = array.load(std::memory_order_relaxed);
+  if (t-b > a->length()-1)
+    a = grow(a,b,t);
+  a->put(t,element);
+  top.store(t+1,std::memory_order_release);
+}
+
+
+template<class T>
+T WorkStealingDeque<T>::pop() {
+  T answer;
+  if (!try_pop(answer))
+    throw EmptyError("WorkStealingDeque::pop");
+
+  return answer;
+}
+
+
+//top is lowered first (claiming the value), then bottom is checked: the
+//  seq_cst fence (paired with the one in try_steal) ensures that a thief
+//  checking top after this sees the lowered value, or this sees its bottom.
+//  Only when one value remains may both take it: they race to CAS bottom.
+template<class T>
+bool WorkStealingDeque<T>::try_pop(T& into) {
+  std::ptrdiff_t t = top.load(std::memory_order_relaxed) - 1;
+  Array* a = array.load(std::memory_order_relaxed);
+  top.store(t,std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::ptrdiff_t b = bottom.load(std::memory_order_relaxed);
+
+  if (b > t) {                   //Was empty
+    top.store(t+1,std::memory_order_relaxed);
+    return false;
+  }
+
+  T value = a->get(t);
+  if (b == t) {                  //Last value: race the thieves for it
+    bool won = bottom.compare_exchange_strong(b,b+1,std::memory_order_seq_cst,std::memory_order_relaxed);
+    top.store(t+1,std::memory_order_relaxed);
+    if (!won)
+      return false;
+  }
+  into = value;
+  return true;
+}
+
+
+//The value is read before the CAS: if another thread advances bottom first,
+//  the value may be stale (or taken), so it is discarded
+template<class T>
+bool WorkStealingDeque<T>::try_steal(T& into) {
+  std::ptrdiff_t b = bottom.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  std::ptrdiff_t t = top.load(std::memory_order_acquire);
+  if (b >= t)
+    return false;
+
+  Array* a = array.load(std::memory_order_acquire);
+  T value = a->get(b);
+  if (!bottom.compare_exchange_strong(b,b+1,std::memory_order_seq_cst,std::memory_order_relaxed))
+    return false;
+
+  into = value;
+  return true;
+}
+
+
+template<class T>
+std::ostream& operator << (std::ostream& outs, const WorkStealingDeque<T>& d) {
+  outs << "work_stealing_deque[";
+
+  auto a = d.array.load();
+  std::ptrdiff_t start = d.bottom.load(), stop = d.top.load();
+  for (std::ptrdiff_t i=start; i<stop; ++i)
+    outs << (i == start ? "" : ",") << a->get(i);
+
+  outs << "]:top";
+  return outs;
+}
+
+
+//Only values in [b,t) are copied (at the same indexes); the new array is
+//  published with release, so a thief loading it sees the copies
+template<class T>
+auto WorkStealingDeque<T>::grow(Array* a, std::ptrdiff_t b, std::ptrdiff_t t) -> Array* {
+  Array* bigger = new Array(2*a->length());
+  for (std::ptrdiff_t i=b; i<t; ++i)
+    bigger->put(i,a->get(i));
+  array.store(bigger,std::memory_order_release);
+
+  a->retired_next = retired;
+  retired = a;
+  return bigger;
+}
+
+}
+
+#endif /* WORK_STEALING_DEQUE_HPP_ */